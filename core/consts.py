@@ -381,6 +381,11 @@ DEFAULT_TIMEOUT = 100
 KLEE_TIMEOUT = 1000
 SMT_SOLVER_TIMEOUT = 1000
 
+# Shared by all Verilated designs under the result directory, see `verilator_compile`
+# $VERILATOR_OBJCACHE_DIR and $VERILATOR_OBJCACHE_MAXSIZE override these
+VERILATOR_OBJCACHE_DIRNAME = 'verilator-objcache'
+VERILATOR_OBJCACHE_MAXSIZE = '2G'
+
 INPUT_FILENAME = 'input'
 STRATEGY_FILENAME = 'strategy.json'
 EXCEPTION_FILENAME = 'exception.log'
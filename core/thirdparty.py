@@ -1,3 +1,4 @@
+import os
 import textwrap
 from itertools import chain, pairwise
 from pathlib import Path
@@ -7,8 +8,10 @@ from typing import Iterable
 from invoke.collection import Collection
 from invoke.tasks import task
 
-from core.consts import DEBUG_CPP_TEMPLATE, DEFAULT_TIMEOUT, KLEE_TIMEOUT, REG_DECLARATION, SMT_SOLVER_TIMEOUT, parser
+from core.consts import (DEBUG_CPP_TEMPLATE, DEFAULT_TIMEOUT, KLEE_TIMEOUT, REG_DECLARATION, SMT_SOLVER_TIMEOUT,
+                         VERILATOR_OBJCACHE_DIRNAME, VERILATOR_OBJCACHE_MAXSIZE, parser)
 from core.ir.crossbar import YosysCxxCrossbar
+from core.workspace import Workspace
 
 
 def _yosys_script_wrapper(script: str):
@@ -176,8 +179,16 @@ def verilator_compile(c, top_module, target_dir):
     makefile = f'V{top_module}.mk'
 
     # NOTE: disable ccache, otherwise wllvm will break down.
+    #       Objects (with their bitcode) of identical Verilated code are reused across designs instead.
+    objcache_dir = os.environ.get('VERILATOR_OBJCACHE_DIR') or (Workspace.result_dir /
+                                                                VERILATOR_OBJCACHE_DIRNAME).as_posix()
+    objcache_maxsize = os.environ.get('VERILATOR_OBJCACHE_MAXSIZE') or VERILATOR_OBJCACHE_MAXSIZE
     c.run(f'make -C {target_dir} -f {makefile} CXX=wllvm++ LINK=wllvm++',
-          env={'CCACHE_DISABLE': '1'},
+          env={
+              'CCACHE_DISABLE': '1',
+              'VERILATOR_OBJCACHE_DIR': objcache_dir,
+              'VERILATOR_OBJCACHE_MAXSIZE': objcache_maxsize
+          },
           timeout=DEFAULT_TIMEOUT)
 
     with c.cd(target_dir):
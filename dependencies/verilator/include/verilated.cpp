@@ -2522,6 +2522,40 @@ void VerilatedContext::internalsDump() const VL_MT_SAFE {
     VerilatedImp::userDump();
 }
 
+std::shared_ptr<VerilatedVirtualBase> VerilatedContext::newThreadPool(unsigned n) {
+    if (n == 0) VL_FATAL_MT(__FILE__, __LINE__, "", "%Error: Simulation threads must be >= 1");
+    if (n == 1) return nullptr;
+
+#if VL_THREADED
+    const unsigned hardwareThreadsAvailable = std::thread::hardware_concurrency();
+    if (n > hardwareThreadsAvailable) {
+        VL_PRINTF_MT("%%Warning: System has %u hardware threads but thread pool size set "
+                     "to %u. This will likely cause significant slowdown.\n",
+                     hardwareThreadsAvailable, n);
+    }
+    // Each task sets the context of the model it is from
+    return std::make_shared<VlThreadPool>(nullptr, n - 1);
+#else
+    VL_PRINTF_MT("%%Warning: Verilator run-time library built without VL_THREADS. Ignoring "
+                 "call to 'VerilatedContext::newThreadPool' with argument %u.\n",
+                 n);
+    return nullptr;
+#endif
+}
+
+void VerilatedContext::threadPool(const std::shared_ptr<VerilatedVirtualBase>& poolp) {
+    if (m_threadPool) {
+        VL_FATAL_MT(
+            __FILE__, __LINE__, "",
+            "%Error: Cannot set thread pool after the thread pool has been created.");
+    }
+
+#if VL_THREADED
+    m_threads = poolp ? static_cast<VlThreadPool*>(poolp.get())->numThreads() + 1 : 1;
+    m_threadPool = poolp;
+#endif
+}
+
 void VerilatedContext::addModel(VerilatedModel* modelp) {
     threadPoolp();  // Ensure thread pool is created, so m_threads cannot change any more
 
@@ -2533,6 +2567,10 @@ void VerilatedContext::addModel(VerilatedModel* modelp) {
         const std::string str = msg.str();
         VL_FATAL_MT(__FILE__, __LINE__, modelp->hierName(), str.c_str());
     }
+#if VL_THREADED
+    // Let the pool order evaluations of models that may run concurrently
+    if (modelp->threads() > 1) static_cast<VlThreadPool*>(threadPoolp())->addModel();
+#endif
 }
 
 VerilatedVirtualBase* VerilatedContext::threadPoolp() {
@@ -402,8 +402,8 @@ protected:
 #else
     const unsigned m_threads = 1;
 #endif
-    // The thread pool shared by all models added to this context
-    std::unique_ptr<VerilatedVirtualBase> m_threadPool;
+    // The thread pool shared by all models added to this context, and maybe other contexts
+    std::shared_ptr<VerilatedVirtualBase> m_threadPool;
     // The execution profiler shared by all models added to this context
     std::unique_ptr<VerilatedVirtualBase> m_executionProfiler;
     // Coverage access
@@ -544,6 +544,14 @@ public:
     /// Set number of threads used for simulation (including the main thread)
     /// Can only be called before the thread pool is created (before first model is added).
     void threads(unsigned n);
+    /// Create a thread pool with the given number of threads (including the main thread),
+    /// for passing to threadPool() of several contexts.
+    static std::shared_ptr<VerilatedVirtualBase> newThreadPool(unsigned n);
+    /// Use a thread pool from newThreadPool(), so that models of this and other contexts
+    /// share the same worker threads and their evaluations interleave, instead of each
+    /// context creating its own pool.  Also sets threads() to the size of the pool.
+    /// Can only be called before the thread pool is created (before first model is added).
+    void threadPool(const std::shared_ptr<VerilatedVirtualBase>& poolp);
 
     /// Allow traces to at some point be enabled (disables some optimizations)
     void traceEverOn(bool flag) VL_MT_SAFE {
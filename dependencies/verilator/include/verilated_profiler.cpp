@@ -74,6 +74,12 @@ VlExecutionProfiler::VlExecutionProfiler(VerilatedContext& context)
     setupThread(0);
 }
 
+VlExecutionProfiler::~VlExecutionProfiler() {
+#if VL_THREADED
+    if (m_threadPoolp) m_threadPoolp->removeProfiler(&m_context);
+#endif
+}
+
 void VlExecutionProfiler::configure() {
 
     if (VL_UNLIKELY(m_enabled)) {
@@ -107,6 +113,13 @@ VerilatedVirtualBase* VlExecutionProfiler::construct(VerilatedContext& context)
     VlExecutionProfiler* const selfp = new VlExecutionProfiler{context};
 #if VL_THREADED
     if (VlThreadPool* const threadPoolp = static_cast<VlThreadPool*>(context.threadPoolp())) {
+        // With a pool from VerilatedContext::threadPool(), records of all contexts
+        // would go to the same per-thread trace buffers
+        if (!threadPoolp->addProfiler(&context)) {
+            VL_FATAL_MT(__FILE__, __LINE__, "",
+                        "%Error: Only one context sharing a thread pool may use --prof-exec");
+        }
+        selfp->m_threadPoolp = threadPoolp;
         for (int i = 0; i < threadPoolp->numThreads(); ++i) {
             // Data to pass to worker thread initialization
             struct Data {
@@ -215,6 +228,11 @@ void VlExecutionProfiler::dump(const char* filenamep, uint64_t tickEnd)
                 fprintf(fp, " id %u predictCost %u\n", payload.m_id, payload.m_predictCost);
                 break;
             }
+            case VlExecutionRecord::Type::SCC_LOOP: {
+                const auto& payload = er.m_payload.sccLoop;
+                fprintf(fp, " id %u iterations %u\n", payload.m_id, payload.m_iterations);
+                break;
+            }
             default: abort();  // LCOV_EXCL_LINE
             }
         }
@@ -63,7 +63,8 @@ VL_ATTR_ALWINLINE QData VL_CPU_TICK() {
     _VL_FOREACH_APPLY(macro, EVAL_LOOP_BEGIN) \
     _VL_FOREACH_APPLY(macro, EVAL_LOOP_END) \
     _VL_FOREACH_APPLY(macro, MTASK_BEGIN) \
-    _VL_FOREACH_APPLY(macro, MTASK_END)
+    _VL_FOREACH_APPLY(macro, MTASK_END) \
+    _VL_FOREACH_APPLY(macro, SCC_LOOP)
 // clang-format on
 
 class VlExecutionRecord final {
@@ -92,6 +93,10 @@ class VlExecutionRecord final {
             uint32_t m_id;  // MTask id
             uint32_t m_predictCost;  // How long scheduler predicted would take
         } mtaskEnd;
+        struct {
+            uint32_t m_id;  // Combinational loop (SCC) id
+            uint32_t m_iterations;  // Number of iterations taken to converge
+        } sccLoop;
     };
 
     // STATE
@@ -124,6 +129,11 @@ public:
         m_payload.mtaskEnd.m_predictCost = predictCost;
         m_type = Type::MTASK_END;
     }
+    void sccLoop(uint32_t id, uint32_t iterations) {
+        m_payload.sccLoop.m_id = id;
+        m_payload.sccLoop.m_iterations = iterations;
+        m_type = Type::SCC_LOOP;
+    }
 };
 
 static_assert(std::is_trivially_destructible<VlExecutionRecord>::value,
@@ -151,6 +161,7 @@ class VlExecutionProfiler final : public VerilatedVirtualBase {
 
     // STATE
     VerilatedContext& m_context;  // The context this profiler is under
+    VlThreadPool* m_threadPoolp = nullptr;  // Pool whose workers record into this profiler
     static VL_THREAD_LOCAL ExecutionTrace t_trace;  // thread-local trace buffers
     mutable VerilatedMutex m_mutex;
     // Map from thread id to &t_trace of given thread
@@ -165,7 +176,7 @@ class VlExecutionProfiler final : public VerilatedVirtualBase {
 public:
     // CONSTRUCTOR
     explicit VlExecutionProfiler(VerilatedContext& context);
-    ~VlExecutionProfiler() override = default;
+    ~VlExecutionProfiler() override;
 
     // METHODS
 
@@ -79,12 +79,18 @@ void VlWorkerThread::wait() {
 
 void VlWorkerThread::workerLoop() {
     ExecRec work;
+    VerilatedContext* contextp = nullptr;  // Context last set from a task
 
     // Wait for the first task without spinning, in case the thread is never actually used.
     dequeWork</* SpinWait: */ false>(&work);
 
     while (true) {
         if (VL_UNLIKELY(work.m_fnp == shutdownTask)) break;
+        // Tasks of models from other contexts sharing the pool
+        if (VL_UNLIKELY(work.m_contextp && work.m_contextp != contextp)) {
+            contextp = work.m_contextp;
+            Verilated::threadContextp(contextp);
+        }
         work.m_fnp(work.m_selfp, work.m_evenCycle);
         // Wait for next task with spinning.
         dequeWork</* SpinWait: */ true>(&work);
@@ -92,7 +98,7 @@ void VlWorkerThread::workerLoop() {
 }
 
 void VlWorkerThread::startWorker(VlWorkerThread* workerp, VerilatedContext* contextp) {
-    Verilated::threadContextp(contextp);
+    if (contextp) Verilated::threadContextp(contextp);
     workerp->workerLoop();
 }
 
@@ -140,11 +140,13 @@ private:
         VlExecFnp m_fnp = nullptr;  // Function to execute
         VlSelfP m_selfp = nullptr;  // Symbol table to execute
         bool m_evenCycle = false;  // Even/odd for flag alternation
+        VerilatedContext* m_contextp = nullptr;  // Context to execute in, nullptr = unchanged
         ExecRec() = default;
-        ExecRec(VlExecFnp fnp, VlSelfP selfp, bool evenCycle)
+        ExecRec(VlExecFnp fnp, VlSelfP selfp, bool evenCycle, VerilatedContext* contextp)
             : m_fnp{fnp}
             , m_selfp{selfp}
-            , m_evenCycle{evenCycle} {}
+            , m_evenCycle{evenCycle}
+            , m_contextp{contextp} {}
     };
 
     // MEMBERS
@@ -191,12 +193,12 @@ public:
         m_ready.erase(m_ready.begin());
         m_ready_size.fetch_sub(1, std::memory_order_relaxed);
     }
-    void addTask(VlExecFnp fnp, VlSelfP selfp, bool evenCycle = false)
-        VL_MT_SAFE_EXCLUDES(m_mutex) {
+    void addTask(VlExecFnp fnp, VlSelfP selfp, bool evenCycle = false,
+                 VerilatedContext* contextp = nullptr) VL_MT_SAFE_EXCLUDES(m_mutex) {
         bool notify;
         {
             const VerilatedLockGuard lock{m_mutex};
-            m_ready.emplace_back(fnp, selfp, evenCycle);
+            m_ready.emplace_back(fnp, selfp, evenCycle, contextp);
             m_ready_size.fetch_add(1, std::memory_order_relaxed);
             notify = m_waiting;
         }
@@ -213,12 +215,17 @@ public:
 class VlThreadPool final : public VerilatedVirtualBase {
     // MEMBERS
     std::vector<VlWorkerThread*> m_workers;  // our workers
+    // Serializes dispatch() when several models use the pool
+    VerilatedMutex m_dispatchMutex;
+    std::atomic<unsigned> m_models{0};  // Number of multithreaded models using the pool
+    std::atomic<VerilatedContext*> m_profilerContextp{nullptr};  // Context using --prof-exec
 
 public:
     // CONSTRUCTORS
     // Construct a thread pool with 'nThreads' dedicated threads. The thread
     // pool will create these threads and make them available to execute tasks
-    // via this->workerp(index)->addTask(...)
+    // via this->workerp(index)->addTask(...). 'contextp' may be nullptr for a
+    // pool shared by several contexts, as each task then names its context.
     VlThreadPool(VerilatedContext* contextp, unsigned nThreads);
     ~VlThreadPool() override;
 
@@ -229,6 +236,38 @@ public:
         assert(index < m_workers.size());
         return m_workers[index];
     }
+    // Note a multithreaded model will dispatch() on this pool
+    void addModel() { ++m_models; }
+    // Note a context's execution profiler records on the workers. The workers'
+    // trace buffers are thread local, so returns false if another context
+    // sharing the pool already does, as each would get the other's records.
+    bool addProfiler(VerilatedContext* contextp) {
+        VerilatedContext* expectedp = nullptr;
+        return m_profilerContextp.compare_exchange_strong(expectedp, contextp)
+               || expectedp == contextp;
+    }
+    void removeProfiler(VerilatedContext* contextp) {
+        m_profilerContextp.compare_exchange_strong(contextp, nullptr);
+    }
+    // Start one evaluation of a model: 'fnps[i]' runs on worker 'i'. Models
+    // sharing the pool may evaluate concurrently. An evaluation's tasks wait on
+    // each other, so a task queued behind another evaluation's task on some
+    // worker must not be needed by that evaluation. Enqueueing each evaluation
+    // atomically gives every worker the evaluations in the same order, so they
+    // interleave on the workers but always complete in dispatch order.
+    void dispatch(const VlExecFnp* fnps, int n, VlSelfP selfp, bool evenCycle,
+                  VerilatedContext* contextp) VL_MT_SAFE_EXCLUDES(m_dispatchMutex) {
+        assert(n <= numThreads());
+        if (VL_LIKELY(m_models.load(std::memory_order_relaxed) <= 1)) {
+            // No other model can interleave
+            for (int i = 0; i < n; ++i) {
+                m_workers[i]->addTask(fnps[i], selfp, evenCycle, contextp);
+            }
+            return;
+        }
+        const VerilatedLockGuard lock{m_dispatchMutex};
+        for (int i = 0; i < n; ++i) m_workers[i]->addTask(fnps[i], selfp, evenCycle, contextp);
+    }
 
 private:
     VL_UNCOPYABLE(VlThreadPool);
@@ -473,6 +473,16 @@ public:
         // cppcheck-suppress invalidPointerCast
         if (VL_UNLIKELY(*reinterpret_cast<double*>(oldp) != newval)) fullDouble(oldp, newval);
     }
+
+    // Check previous dumped values of an array of signals held contiguously in
+    // the model. Values are compared a block at a time, then trace entries are
+    // emitted only for the elements that differ.
+    void chgBitArray(uint32_t* oldp, const CData* newvalp, int elements);
+    void chgCDataArray(uint32_t* oldp, const CData* newvalp, int elements, int bits);
+    void chgSDataArray(uint32_t* oldp, const SData* newvalp, int elements, int bits);
+    void chgIDataArray(uint32_t* oldp, const IData* newvalp, int elements, int bits);
+    void chgQDataArray(uint32_t* oldp, const QData* newvalp, int elements, int bits);
+    void chgWDataArray(uint32_t* oldp, const WData* newvalp, int elements, int bits);
 };
 
 #ifdef VL_THREADED
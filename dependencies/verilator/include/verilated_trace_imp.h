@@ -844,6 +844,116 @@ static inline void cvtQDataToStr(char* dstp, QData value) {
 
 #define cvtEDataToStr cvtIDataToStr
 
+//=========================================================================
+// Primitives comparing blocks of previous values against new values...
+
+// All of these compare 8 consecutive 32-bit previous values against 8 new
+// values, zero extended to 32-bits, and return a mask with bit 'i' set if
+// lane 'i' differs.
+
+#ifdef VL_HAVE_SSE2
+static inline uint32_t chgDiffLanes8(const uint32_t* oldp, __m128i lo, __m128i hi) {
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(oldp));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(oldp + 4));
+    const uint32_t eqlo = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, lo)));
+    const uint32_t eqhi = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(b, hi)));
+    return ~(eqlo | (eqhi << 4)) & 0xff;
+}
+#endif
+
+#ifdef VL_HAVE_AVX2
+static inline uint32_t chgDiffLanes8(const uint32_t* oldp, __m256i newval) {
+    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(oldp));
+    const uint32_t eq = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, newval)));
+    return ~eq & 0xff;
+}
+#endif
+
+template <typename T_Value>
+static inline uint32_t chgDiffLanes8Scalar(const uint32_t* oldp, const T_Value* newvalp) {
+    uint32_t diff = 0;
+    for (int i = 0; i < 8; ++i) diff |= static_cast<uint32_t>(oldp[i] != newvalp[i]) << i;
+    return diff;
+}
+
+static inline uint32_t chgDiffLanes8(const uint32_t* oldp, const CData* newvalp) {
+#if defined(VL_HAVE_AVX2)
+    const __m128i a = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(newvalp));
+    return chgDiffLanes8(oldp, _mm256_cvtepu8_epi32(a));
+#elif defined(VL_HAVE_SSE2)
+    // Zero extend the 8 bytes to 8 halfwords, then each half to 4 words
+    const __m128i z = _mm_setzero_si128();
+    const __m128i a = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(newvalp));
+    const __m128i b = _mm_unpacklo_epi8(a, z);
+    return chgDiffLanes8(oldp, _mm_unpacklo_epi16(b, z), _mm_unpackhi_epi16(b, z));
+#else
+    return chgDiffLanes8Scalar(oldp, newvalp);
+#endif
+}
+
+static inline uint32_t chgDiffLanes8(const uint32_t* oldp, const SData* newvalp) {
+#if defined(VL_HAVE_AVX2)
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(newvalp));
+    return chgDiffLanes8(oldp, _mm256_cvtepu16_epi32(a));
+#elif defined(VL_HAVE_SSE2)
+    const __m128i z = _mm_setzero_si128();
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(newvalp));
+    return chgDiffLanes8(oldp, _mm_unpacklo_epi16(a, z), _mm_unpackhi_epi16(a, z));
+#else
+    return chgDiffLanes8Scalar(oldp, newvalp);
+#endif
+}
+
+static inline uint32_t chgDiffLanes8(const uint32_t* oldp, const uint32_t* newvalp) {
+#if defined(VL_HAVE_AVX2)
+    return chgDiffLanes8(oldp, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(newvalp)));
+#elif defined(VL_HAVE_SSE2)
+    return chgDiffLanes8(oldp, _mm_loadu_si128(reinterpret_cast<const __m128i*>(newvalp)),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(newvalp + 4)));
+#else
+    return chgDiffLanes8Scalar(oldp, newvalp);
+#endif
+}
+
+// Compare an array of narrow elements, each using one previous value word,
+// calling 'full(i)' for each element 'i' that differs
+template <typename T_Value, typename T_Full>
+static inline void chgNarrowArray(const uint32_t* oldp, const T_Value* newvalp, int elements,
+                                  T_Full full) {
+    int i = 0;
+    for (; i + 8 <= elements; i += 8) {
+        uint32_t diff = chgDiffLanes8(oldp + i, newvalp + i);
+        for (int lane = i; VL_UNLIKELY(diff); ++lane, diff >>= 1) {
+            if (diff & 1) full(lane);
+        }
+    }
+    for (; i < elements; ++i) {
+        if (VL_UNLIKELY(oldp[i] != newvalp[i])) full(i);
+    }
+}
+
+// Compare an array of elements of 'words' previous value words each, laid
+// out identically in the model, calling 'full(i)' for each element 'i' that
+// differs. Calling 'full' updates all words of the element, so rechecking the
+// word makes sure each element is emitted once, even if it spans blocks.
+template <typename T_Full>
+static inline void chgWordsArray(const uint32_t* oldp, const uint32_t* newvalp, int elements,
+                                 int words, T_Full full) {
+    const int nwords = elements * words;
+    int i = 0;
+    for (; i + 8 <= nwords; i += 8) {
+        const uint32_t diff = chgDiffLanes8(oldp + i, newvalp + i);
+        if (VL_LIKELY(!diff)) continue;
+        for (int lane = 0; lane < 8; ++lane) {
+            const int w = i + lane;
+            if ((diff & (1U << lane)) && oldp[w] != newvalp[w]) full(w / words);
+        }
+    }
+    for (; i < nwords; ++i) {
+        if (VL_UNLIKELY(oldp[i] != newvalp[i])) full(i / words);
+    }
+}
+
 //=========================================================================
 // VerilatedTraceBuffer
 
@@ -915,6 +1025,56 @@ void VerilatedTraceBuffer<VL_BUF_T>::fullDouble(uint32_t* oldp, double newval) {
     emitDouble(code, newval);
 }
 
+template <>
+void VerilatedTraceBuffer<VL_BUF_T>::chgBitArray(uint32_t* oldp, const CData* newvalp,
+                                                 int elements) {
+    chgNarrowArray(oldp, newvalp, elements,
+                   [this, oldp, newvalp](int i) { fullBit(oldp + i, newvalp[i]); });
+}
+
+template <>
+void VerilatedTraceBuffer<VL_BUF_T>::chgCDataArray(uint32_t* oldp, const CData* newvalp,
+                                                   int elements, int bits) {
+    chgNarrowArray(oldp, newvalp, elements, [this, oldp, newvalp, bits](int i) {
+        fullCData(oldp + i, newvalp[i], bits);
+    });
+}
+
+template <>
+void VerilatedTraceBuffer<VL_BUF_T>::chgSDataArray(uint32_t* oldp, const SData* newvalp,
+                                                   int elements, int bits) {
+    chgNarrowArray(oldp, newvalp, elements, [this, oldp, newvalp, bits](int i) {
+        fullSData(oldp + i, newvalp[i], bits);
+    });
+}
+
+template <>
+void VerilatedTraceBuffer<VL_BUF_T>::chgIDataArray(uint32_t* oldp, const IData* newvalp,
+                                                   int elements, int bits) {
+    chgNarrowArray(oldp, newvalp, elements, [this, oldp, newvalp, bits](int i) {
+        fullIData(oldp + i, newvalp[i], bits);
+    });
+}
+
+template <>
+void VerilatedTraceBuffer<VL_BUF_T>::chgQDataArray(uint32_t* oldp, const QData* newvalp,
+                                                   int elements, int bits) {
+    // The previous value buffer holds each quad in the host's memory layout
+    chgWordsArray(oldp, reinterpret_cast<const uint32_t*>(newvalp), elements, 2,
+                  [this, oldp, newvalp, bits](int i) {
+                      fullQData(oldp + 2 * i, newvalp[i], bits);
+                  });
+}
+
+template <>
+void VerilatedTraceBuffer<VL_BUF_T>::chgWDataArray(uint32_t* oldp, const WData* newvalp,
+                                                   int elements, int bits) {
+    const int words = VL_WORDS_I(bits);
+    chgWordsArray(oldp, newvalp, elements, words, [this, oldp, newvalp, bits, words](int i) {
+        fullWData(oldp + i * words, newvalp + i * words, bits);
+    });
+}
+
 #ifdef VL_THREADED
 //=========================================================================
 // VerilatedTraceOffloadBuffer
@@ -1004,6 +1004,43 @@ std::string VL_TO_STRING(const VlUnpacked<T_Value, T_Depth>& obj) {
     return obj.to_string();
 }
 
+//===================================================================
+// Commit queue for non-blocking assignments to the elements of an unpacked
+// array. Each delayed write appends an index/value record, and 'commit'
+// applies the records in the order they were added (so the last write to an
+// element wins) in the NBA region, then empties the queue. This replaces the
+// per assignment shadow variables for arrays written from many places or
+// from loops. The storage is retained across commits, so there is no
+// allocation in the steady state.
+// There are no multithreaded locks on this; with --threads each process
+// writing the array has its own queue
+
+template <class T_Value>
+class VlNBACommitQueue final {
+    // TYPES
+    struct Entry final {
+        IData m_index;  // Element written
+        T_Value m_value;  // Value written
+    };
+
+    // MEMBERS
+    std::vector<Entry> m_pending;  // Writes not yet committed, in order
+
+public:
+    // CONSTRUCTORS
+    VlNBACommitQueue() = default;
+    ~VlNBACommitQueue() = default;
+    VL_UNCOPYABLE(VlNBACommitQueue);
+
+    // METHODS
+    void enqueue(const T_Value& value, IData index) { m_pending.push_back(Entry{index, value}); }
+    template <typename T_Array>
+    void commit(T_Array& array) {
+        for (const Entry& entry : m_pending) array[entry.m_index] = entry.m_value;
+        m_pending.clear();
+    }
+};
+
 class VlClass;  // See below
 
 //===================================================================
@@ -0,0 +1,167 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Memory used to keep source text for messages, see VFileContent
+//
+// Compares how much memory holding a large source file takes when it is
+// stored as one string per line (the old VFileContent), as one deque<char>
+// with line start offsets (text pushed by the parser), or as line start
+// offsets into a memory mapping (files read by the preprocessor).
+//
+// Build and run, once per mode so each measures a fresh process:
+//
+//   g++ -O2 -std=c++14 -o filecontent_mem filecontent_mem.cpp
+//   for m in lines text mapped; do ./filecontent_mem $m [file.v | -lines N]; done
+//
+// Without a file, a gate-level style netlist of N lines (default 5M) is
+// generated in memory.  Text is pushed in 4 kB chunks, as the parser does.
+//
+// Code available from: https://verilator.org
+//
+// Copyright 2024 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static constexpr size_t CHUNK = 4096;
+
+// Peak resident set size of this process, in kB
+static long peakKb() {
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_maxrss;
+}
+
+// Old VFileContent: every line kept as its own string
+struct LineStore final {
+    std::deque<std::string> m_lines;
+    void pushText(const char* textp, size_t len) {
+        if (m_lines.empty()) {
+            m_lines.emplace_back("");  // no such thing as line [0]
+            m_lines.emplace_back("");  // start with no leftover
+        }
+        std::string leftover = m_lines.back();
+        m_lines.pop_back();
+        const char* cp = textp;
+        const char* const endp = textp + len;
+        while (const char* const nlp
+               = static_cast<const char*>(std::memchr(cp, '\n', endp - cp))) {
+            m_lines.emplace_back(leftover + std::string(cp, nlp + 1));
+            leftover.clear();
+            cp = nlp + 1;
+        }
+        m_lines.emplace_back(leftover + std::string(cp, endp));
+    }
+    size_t lines() const { return m_lines.size(); }
+};
+
+// New VFileContent: text in one deque<char> or a mapping, plus line starts
+struct OffsetStore final {
+    std::deque<char> m_text;
+    std::deque<size_t> m_lineStarts;
+    void indexLines(size_t offset, const char* textp, size_t len) {
+        if (m_lineStarts.empty()) {
+            m_lineStarts.push_back(0);  // no such thing as line [0]
+            m_lineStarts.push_back(0);  // start with no leftover
+        }
+        const char* cp = textp;
+        const char* const endp = textp + len;
+        while (const char* const nlp
+               = static_cast<const char*>(std::memchr(cp, '\n', endp - cp))) {
+            cp = nlp + 1;
+            m_lineStarts.push_back(offset + (cp - textp));
+        }
+    }
+    void pushText(const char* textp, size_t len) {
+        const size_t offset = m_text.size();
+        m_text.insert(m_text.end(), textp, textp + len);
+        indexLines(offset, textp, len);
+    }
+    size_t lines() const { return m_lineStarts.size(); }
+};
+
+static std::string netlist(size_t nlines) {
+    static const char* const cells[] = {"AND2X1", "OR2X2", "NAND3X1", "DFFRX1", "INVX4"};
+    std::string text;
+    text.reserve(nlines * 64);  // Untouched pages aren't resident, growing would raise the peak
+    char buf[160];
+    for (size_t i = 0; i < nlines; ++i) {
+        const int len = std::snprintf(buf, sizeof(buf),
+                                      "  %s u%zu (.A(n%zu), .B(n%zu), .Y(n%zu));\n",
+                                      cells[i % 5], i, i * 7 % nlines, i * 13 % nlines, i);
+        text.append(buf, len);
+    }
+    return text;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s lines|text|mapped [file | -lines N]\n", argv[0]);
+        return 2;
+    }
+    const std::string mode = argv[1];
+    const char* textp = nullptr;
+    size_t size = 0;
+    std::string generated;
+    if (argc > 2 && std::strcmp(argv[2], "-lines")) {
+        const int fd = open(argv[2], O_RDONLY);
+        struct stat st;
+        if (fd < 0 || fstat(fd, &st)) {
+            std::perror(argv[2]);
+            return 1;
+        }
+        size = st.st_size;
+        textp = static_cast<const char*>(mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0));
+        close(fd);
+    } else {
+        generated = netlist(argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 5000000);
+        size = generated.size();
+        textp = generated.data();
+    }
+
+    const long beforeKb = peakKb();
+    size_t nlines = 0;
+    size_t indexKb = 0;
+    if (mode == "lines") {
+        LineStore store;
+        for (size_t pos = 0; pos < size; pos += CHUNK) {
+            store.pushText(textp + pos, std::min(CHUNK, size - pos));
+        }
+        nlines = store.lines();
+    } else if (mode == "text") {
+        OffsetStore store;
+        for (size_t pos = 0; pos < size; pos += CHUNK) {
+            store.pushText(textp + pos, std::min(CHUNK, size - pos));
+        }
+        nlines = store.lines();
+    } else if (mode == "mapped") {
+        // Text stays in the mapping; only the offsets are stored
+        OffsetStore store;
+        store.indexLines(0, textp, size);
+        nlines = store.lines();
+        indexKb = nlines * sizeof(size_t) / 1024;
+    } else {
+        std::fprintf(stderr, "%s: unknown mode '%s'\n", argv[0], mode.c_str());
+        return 2;
+    }
+    const long growthKb = peakKb() - beforeKb;
+    std::printf("%-7s %6zu MB text  %9zu lines  peak RSS growth %6ld MB", mode.c_str(),
+                size >> 20, nlines, growthKb / 1024);
+    if (indexKb) std::printf("  (offsets %zu MB)", indexKb / 1024);
+    std::printf("\n");
+    return 0;
+}
@@ -0,0 +1,46 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Benchmark driver for nodist/bench designs
+//
+// Copyright 2022 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+
+#include "verilated.h"
+
+#include "Vbench.h"
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+int main(int argc, char** argv) {
+    const uint64_t cycles = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    const std::unique_ptr<Vbench> topp{new Vbench{contextp.get()}};
+    topp->clk = 0;
+    topp->eval();
+
+    // Time only the clock cycles, not construction and initial blocks
+    const auto start = std::chrono::steady_clock::now();
+    for (uint64_t cycle = 0; cycle < cycles && !contextp->gotFinish(); ++cycle) {
+        topp->clk = 1;
+        topp->eval();
+        topp->clk = 0;
+        topp->eval();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    topp->final();
+    // Printing the result keeps the design from being optimized away
+    std::printf("bench: cycles %" PRIu64 " seconds %.6f result %08x\n", cycles, elapsed.count(),
+                static_cast<unsigned>(topp->result));
+    return 0;
+}
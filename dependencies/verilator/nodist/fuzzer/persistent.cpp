@@ -0,0 +1,139 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator in-process fuzzing entry point
+//
+// Copyright 2022 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//*************************************************************************
+
+// libFuzzer style entry point, also usable by AFL++ in persistent mode,
+// that Verilates each input in this process, so the fuzzer sees the
+// coverage of each run.  Build with ./setup_persistent, which links this
+// against the Verilator objects.
+//
+// Between inputs V3Global::reset() returns the netlist, options, file and
+// message tables, preprocessor, configuration and statistics to how they
+// were at startup, and Verilator's exit on an error in the input becomes a
+// throw back to here, see V3Error::exitCb.  Not reset yet are function
+// statics in the passes, the lexers' state after an error part way through
+// a token, and other globals of individual passes.  A crash that does not
+// reproduce when its input is run alone ("./persistent <crash-file>") came
+// from such state.  Setting VERILATOR_FUZZ_FORK Verilates each input in a
+// child forked from this already loaded process instead, which always
+// starts from the same clean state but hides the coverage from libFuzzer;
+// ./run still fuzzes verilator_bin itself through wrapper.cpp.
+//
+// Internal errors abort, which is reported as a crash; user errors in the
+// input are expected and ignored.
+
+#include "V3Error.h"
+#include "V3Global.h"
+#include "V3Os.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef __linux__
+# include <sys/prctl.h>
+#endif
+
+int verilatorMain(int argc, char** argv);
+
+static std::string s_workDir;  // Where the input and output files go
+static pid_t s_fuzzerPid = 0;  // Process running the fuzzer, not a child Verilating
+static bool s_fork = false;  // Verilate each input in a forked child, see VERILATOR_FUZZ_FORK
+
+struct VerilatorExit final {};  // Thrown instead of exiting on an error in the input
+
+// Sanitizers must abort, not exit(1) as a user error does, to be seen as crashes.
+// Verilator does not free FileLines and such by design, so leaks are not bugs.
+extern "C" const char* __asan_default_options() { return "abort_on_error=1:detect_leaks=0"; }
+extern "C" const char* __ubsan_default_options() { return "abort_on_error=1"; }
+
+extern "C" int LLVMFuzzerInitialize(int*, char***) {
+    // Prefer memory backed storage for files Verilator writes
+    const char* const shmp = "/dev/shm";
+    const char* const tmpp = getenv("TMPDIR");
+    s_workDir = (access(shmp, W_OK) == 0 ? shmp : tmpp ? tmpp : "/tmp");
+    s_workDir += "/verilator_fuzz_" + std::to_string(getpid());
+    V3Os::createDir(s_workDir);
+    s_fuzzerPid = getpid();
+    s_fork = getenv("VERILATOR_FUZZ_FORK") != nullptr;
+    V3Error::abortOnFatalSrc(true);
+    if (!s_fork) V3Error::exitCb([] { throw VerilatorExit{}; });
+    std::atexit([] {
+        if (getpid() != s_fuzzerPid) return;  // Child exiting on an error
+        V3Os::unlinkRegexp(s_workDir + "/obj_dir", "*");
+        rmdir((s_workDir + "/obj_dir").c_str());
+        V3Os::unlinkRegexp(s_workDir, "*");
+        rmdir(s_workDir.c_str());
+    });
+    return 0;
+}
+
+static void verilate(const std::string& filename, const std::string& mdir) {
+    std::vector<std::string> args{"verilator_bin", "--cc", "--Mdir", mdir,
+                                  "--output-archive", "/dev/null", filename};
+    std::vector<char*> argv;
+    for (std::string& arg : args) argv.push_back(&arg[0]);
+    argv.push_back(nullptr);
+    verilatorMain(static_cast<int>(args.size()), argv.data());
+}
+
+static void verilateInProcess(const std::string& filename, const std::string& mdir) {
+    try {
+        verilate(filename, mdir);
+    } catch (const VerilatorExit&) {
+        // Error in the input, already reported
+    }
+    v3Global.reset();
+}
+
+static void verilateForked(const std::string& filename, const std::string& mdir) {
+    const pid_t pid = fork();
+    if (pid < 0) abort();
+    if (pid == 0) {
+#ifdef __linux__
+        // Don't outlive the fuzzer if it gives up on a hung input
+        prctl(PR_SET_PDEATHSIG, SIGKILL);
+#endif
+        verilate(filename, mdir);
+        std::exit(0);
+    }
+
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0) {}
+    if (WIFSIGNALED(status)) {
+        // Child already printed the details, just report the crash on this input
+        std::fprintf(stderr, "%%Error: Verilator killed by signal %d\n", WTERMSIG(status));
+        abort();
+    }
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* datap, size_t size) {
+    const std::string filename = s_workDir + "/fuzz.v";
+    const std::string mdir = s_workDir + "/obj_dir";
+    FILE* const fp = fopen(filename.c_str(), "wb");
+    if (!fp) abort();
+    if (size && fwrite(datap, size, 1, fp) != 1) abort();
+    fclose(fp);
+
+    if (s_fork) {
+        verilateForked(filename, mdir);
+    } else {
+        verilateInProcess(filename, mdir);
+    }
+    // Results from the previous input must not change this one's, though
+    // with --output-archive few if any files are written
+    V3Os::unlinkRegexp(mdir, "*");
+    return 0;
+}
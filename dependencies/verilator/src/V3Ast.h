@@ -42,6 +42,8 @@
 // Forward declarations
 class V3Graph;
 class ExecMTask;
+class VNCheckpointReader;
+class VNCheckpointWriter;
 
 // Hint class so we can choose constructors
 class VFlagLogicPacked {};
@@ -462,6 +464,7 @@ public:
         TRIGGER_SCHEDULER,
         DYNAMIC_TRIGGER_SCHEDULER,
         FORK_SYNC,
+        NBA_COMMIT_QUEUE,
         // Unsigned and two state; fundamental types
         UINT32,
         UINT64,
@@ -493,6 +496,7 @@ public:
                                             "VlTriggerScheduler",
                                             "VlDynamicTriggerScheduler",
                                             "VlFork",
+                                            "VlNBACommitQueue",
                                             "IData",
                                             "QData",
                                             "LOGIC_IMPLICIT",
@@ -501,11 +505,12 @@ public:
     }
     const char* dpiType() const {
         static const char* const names[]
-            = {"%E-unk",        "svBit",         "char",         "void*",           "char",
-               "int",           "%E-integer",    "svLogic",      "long long",       "double",
-               "short",         "%E-time",       "const char*",  "dpiScope",        "const char*",
-               "%E-mtaskstate", "%E-triggervec", "%E-dly-sched", "%E-trig-sched",   "%E-dyn-sched",
-               "%E-fork",       "IData",         "QData",        "%E-logic-implct", " MAX"};
+            = {"%E-unk",        "svBit",         "char",         "void*",        "char",
+               "int",           "%E-integer",    "svLogic",      "long long",    "double",
+               "short",         "%E-time",       "const char*",  "dpiScope",     "const char*",
+               "%E-mtaskstate", "%E-triggervec", "%E-dly-sched", "%E-trig-sched", "%E-dyn-sched",
+               "%E-fork",       "%E-nba-queue",  "IData",        "QData",        "%E-logic-implct",
+               " MAX"};
         return names[m_e];
     }
     static void selfTest() {
@@ -544,6 +549,7 @@ public:
         case TRIGGER_SCHEDULER: return 0;  // opaque
         case DYNAMIC_TRIGGER_SCHEDULER: return 0;  // opaque
         case FORK_SYNC: return 0;  // opaque
+        case NBA_COMMIT_QUEUE: return 0;  // opaque
         case UINT32: return 32;
         case UINT64: return 64;
         default: return 0;
@@ -582,7 +588,7 @@ public:
         return (m_e == EVENT || m_e == STRING || m_e == SCOPEPTR || m_e == CHARPTR
                 || m_e == MTASKSTATE || m_e == TRIGGERVEC || m_e == DELAY_SCHEDULER
                 || m_e == TRIGGER_SCHEDULER || m_e == DYNAMIC_TRIGGER_SCHEDULER || m_e == FORK_SYNC
-                || m_e == DOUBLE);
+                || m_e == NBA_COMMIT_QUEUE || m_e == DOUBLE);
     }
     bool isDouble() const VL_MT_SAFE { return m_e == DOUBLE; }
     bool isEvent() const { return m_e == EVENT; }
@@ -1555,6 +1561,7 @@ public:
 protected:
     // CONSTRUCTORS
     AstNode(VNType t, FileLine* fl);
+    AstNode(VNType t, VNCheckpointReader& cp);  // See V3Checkpoint
     virtual AstNode* clone() = 0;  // Generally, cloneTree is what you want instead
     virtual void cloneRelink() {}
     void cloneRelinkTree();
@@ -1632,6 +1639,7 @@ public:
     static void* operator new(size_t size);
     static void operator delete(void* obj, size_t size);
 #endif
+    void checkpointWrite(VNCheckpointWriter& cp) const;  // See V3Checkpoint
 
     // CONSTANTS
     // The following are relative dynamic costs (~ execution cycle count) of various operations.
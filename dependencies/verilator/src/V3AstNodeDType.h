@@ -121,6 +121,8 @@ public:
     std::pair<uint32_t, uint32_t> dimensions(bool includeBasic);
     uint32_t arrayUnpackedElements();  // 1, or total multiplication of all dimensions
     static int uniqueNumInc() { return ++s_uniqueNum; }
+    static int uniqueNum() { return s_uniqueNum; }
+    static void uniqueNum(int value) { s_uniqueNum = value; }
     const char* charIQWN() const {
         return (isString() ? "N" : isWide() ? "W" : isQuad() ? "Q" : "I");
     }
@@ -355,6 +357,9 @@ public:
 class AstBasicDType final : public AstNodeDType {
     // Builtin atomic/vectored data type
     // @astgen op1 := rangep : Optional[AstRange] // Range of variable
+    friend class VNCheckpointReader;
+    friend class VNCheckpointWriter;
+
 private:
     struct Members {
         VBasicDTypeKwd m_keyword;  // (also in VBasicTypeKey) What keyword created basic type
@@ -434,6 +439,9 @@ public:
     bool isEvent() const VL_MT_SAFE { return keyword() == VBasicDTypeKwd::EVENT; }
     bool isTriggerVec() const VL_MT_SAFE { return keyword() == VBasicDTypeKwd::TRIGGERVEC; }
     bool isForkSync() const VL_MT_SAFE { return keyword() == VBasicDTypeKwd::FORK_SYNC; }
+    bool isNbaCommitQueue() const VL_MT_SAFE {
+        return keyword() == VBasicDTypeKwd::NBA_COMMIT_QUEUE;
+    }
     bool isDelayScheduler() const VL_MT_SAFE {
         return keyword() == VBasicDTypeKwd::DELAY_SCHEDULER;
     }
@@ -591,6 +599,7 @@ class AstDefImplicitDType final : public AstNodeDType {
     // This allows "var enum {...} a,b" to share the enum definition for both variables
     // After link, these become typedefs
     // @astgen op1 := childDTypep : Optional[AstNodeDType]
+    // @astgen nocheckpoint := m_containerp
 private:
     string m_name;
     void* m_containerp;  // In what scope is the name unique, so we can know what are duplicate
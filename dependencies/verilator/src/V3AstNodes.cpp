@@ -758,6 +758,19 @@ AstNodeDType::CTypeRecursed AstNodeDType::cTypeRecurse(bool compound) const {
             info.m_type = "VlDynamicTriggerScheduler";
         } else if (bdtypep->isForkSync()) {
             info.m_type = "VlForkSync";
+        } else if (bdtypep->isNbaCommitQueue()) {
+            // The width is that of the array elements the queue holds
+            string elem = "VlWide<" + cvtToStr(dtypep->widthWords()) + ">";
+            if (dtypep->widthMin() <= 8) {
+                elem = "CData";
+            } else if (dtypep->widthMin() <= 16) {
+                elem = "SData";
+            } else if (dtypep->widthMin() <= VL_IDATASIZE) {
+                elem = "IData";
+            } else if (dtypep->isQuad()) {
+                elem = "QData";
+            }
+            info.m_type = "VlNBACommitQueue<" + elem + ">";
         } else if (bdtypep->isEvent()) {
             info.m_type = "VlEvent";
         } else if (dtypep->widthMin() <= 8) {  // Handle unpacked arrays; not bdtypep->width
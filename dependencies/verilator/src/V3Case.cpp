@@ -24,9 +24,11 @@
 //                                                  (other items))
 //                                              body
 //              Or, converts to a if/else tree.
+//          Large or sparse tables with constants and no masking (address muxes, decoders)
+//              Enter all into std::map, merge adjacent values with the same item into
+//              runs, and use a balanced tree of < compares with a range compare at
+//              each leaf, when V3InstrCount estimates it beats the if/else tree.
 //      FUTURES:
-//          Large 16+ bit tables with constants and no masking (address muxes)
-//              Enter all into std::multimap, sort by value and use a tree of < and == compares.
 //          "Diagonal" find of {rightmost,leftmost} bit {set,clear}
 //              Ignoring mask, check each value is unique (using std::multimap as above?)
 //              Each branch is then mask-and-compare operation (IE
@@ -41,15 +43,20 @@
 
 #include "V3Ast.h"
 #include "V3Global.h"
+#include "V3InstrCount.h"
 #include "V3Stats.h"
 
 #include <algorithm>
+#include <cmath>
+#include <map>
 
 VL_DEFINE_DEBUG_FUNCTIONS;
 
 #define CASE_OVERLAP_WIDTH 16  // Maximum width we can check for overlaps in
 #define CASE_BARF 999999  // Magic width when non-constant
 #define CASE_ENCODER_GROUP_DEPTH 8  // Levels of priority to be ORed together in top IF tree
+#define CASE_SEARCH_MIN_VALUES 8  // Minimum constant values to consider a compare tree
+#define CASE_SEARCH_CLONE_NODES 1000  // Maximum extra nodes cloned to build a compare tree
 
 //######################################################################
 
@@ -129,6 +136,7 @@ private:
     // STATE
     VDouble0 m_statCaseFast;  // Statistic tracking
     VDouble0 m_statCaseSlow;  // Statistic tracking
+    VDouble0 m_statCaseSearch;  // Statistic tracking
     const AstNode* m_alwaysp = nullptr;  // Always in which case is located
 
     // Per-CASE
@@ -137,6 +145,14 @@ private:
     bool m_caseNoOverlapsAllCovered = false;  // Proven to be synopsys parallel_case compliant
     // For each possible value, the case branch we need
     std::array<AstNode*, 1 << CASE_OVERLAP_WIDTH> m_valueItem;
+    // For compare trees, contiguous values selecting the same case item, in ascending order
+    struct CaseRun final {
+        uint64_t m_lo;  // First value in run
+        uint64_t m_hi;  // Last value in run
+        AstCaseItem* m_itemp;  // Item selected by the run
+    };
+    std::vector<CaseRun> m_caseRuns;
+    AstCaseItem* m_caseDefaultp = nullptr;  // Default item, or nullptr
 
     // METHODS
 
@@ -332,6 +348,140 @@ private:
         if (debug() >= 9) ifrootp->dumpTree(cout, "    _simp: ");
     }
 
+    static int stmtsCount(const AstNode* stmtsp) {
+        int count = 0;
+        for (const AstNode* nodep = stmtsp; nodep; nodep = nodep->nextp()) {
+            count += nodep->nodeCount();
+        }
+        return count;
+    }
+
+    bool isCaseTreeSearch(AstCase* nodep) {
+        // Only exact constant compares of up to a quad selector; masks go to the if/else tree
+        const AstNode* const cexprp = nodep->exprp();
+        const int width = cexprp->width();
+        if (width == 0 || width > VL_QUADSIZE || cexprp->isDouble() || cexprp->isString()) {
+            return false;
+        }
+        // V3InstrCount can't cost these, and they are too rare here to matter
+        if (cexprp->exists([](const AstNode* np) {  //
+                return VN_IS(np, SliceSel) || VN_IS(np, MemberSel);
+            })) {
+            return false;
+        }
+        std::map<uint64_t, AstCaseItem*> valueItems;
+        m_caseDefaultp = nullptr;
+        for (AstCaseItem* itemp = nodep->itemsp(); itemp;
+             itemp = VN_AS(itemp->nextp(), CaseItem)) {
+            if (itemp->isDefault()) m_caseDefaultp = itemp;
+            for (AstNode* icondp = itemp->condsp(); icondp; icondp = icondp->nextp()) {
+                AstConst* const iconstp = VN_CAST(icondp, Const);
+                if (!iconstp || iconstp->width() != width) return false;
+                if (neverItem(nodep, iconstp)) continue;  // X in casez can't ever be executed
+                if (iconstp->num().isFourState()) return false;  // Wildcard, needs a mask
+                // Earlier items have priority over later overlapping ones
+                valueItems.emplace(iconstp->num().toUQuad(), itemp);
+            }
+        }
+        if (valueItems.size() < CASE_SEARCH_MIN_VALUES) return false;
+        m_caseRuns.clear();
+        for (const auto& itr : valueItems) {
+            if (!m_caseRuns.empty() && m_caseRuns.back().m_itemp == itr.second
+                && m_caseRuns.back().m_hi + 1 == itr.first) {
+                m_caseRuns.back().m_hi = itr.first;
+            } else {
+                m_caseRuns.push_back({itr.first, itr.first, itr.second});
+            }
+        }
+        // Cost model: the if/else tree tests half the values on average, the
+        // compare tree one run per level plus the final range compare
+        const double compareCost = V3InstrCount::count(nodep->exprp(), false) + 1;
+        const double chainCost = (valueItems.size() + 1) / 2.0 * compareCost;
+        const double treeCost = (std::ceil(std::log2(m_caseRuns.size())) + 1) * compareCost;
+        if (treeCost >= chainCost) return false;
+        // Items split across runs, and the default in each leaf, are cloned into the tree
+        std::map<const AstCaseItem*, int> itemRuns;
+        for (const CaseRun& run : m_caseRuns) ++itemRuns[run.m_itemp];
+        int cloneNodes = 0;
+        for (const auto& itr : itemRuns) {
+            cloneNodes += (itr.second - 1) * stmtsCount(itr.first->stmtsp());
+        }
+        if (m_caseDefaultp) {
+            cloneNodes += m_caseRuns.size() * stmtsCount(m_caseDefaultp->stmtsp());
+        }
+        if (cloneNodes > CASE_SEARCH_CLONE_NODES) return false;
+        UINFO(8, "Search case statement: " << nodep << endl);
+        return true;
+    }
+
+    AstNode* newCaseSearchConst(AstNode* cexprp, uint64_t value) {
+        V3Number num{cexprp, cexprp->width()};
+        num.setQuad(value);
+        return new AstConst{cexprp->fileline(), num};
+    }
+
+    AstNode* replaceCaseSearchRecurse(AstNode* cexprp, size_t first, size_t last, uint64_t lo,
+                                      uint64_t hi) {
+        // All values in [lo, hi] not covered by m_caseRuns[first..last] take the default
+        FileLine* const fl = cexprp->fileline();
+        if (first == last) {
+            const CaseRun& run = m_caseRuns[first];
+            AstNode* const stmtsp
+                = run.m_itemp->stmtsp() ? run.m_itemp->stmtsp()->cloneTree(true) : nullptr;
+            if (run.m_lo == lo && run.m_hi == hi) return stmtsp;
+            // Only compare against the bounds not already known from the tree above
+            AstNode* condp = nullptr;
+            if (run.m_lo == run.m_hi) {
+                condp = AstEq::newTyped(fl, cexprp->cloneTree(false),
+                                        newCaseSearchConst(cexprp, run.m_lo));
+            } else {
+                if (run.m_lo != lo) {
+                    condp = new AstGte{fl, cexprp->cloneTree(false),
+                                       newCaseSearchConst(cexprp, run.m_lo)};
+                }
+                if (run.m_hi != hi) {
+                    AstNode* const ltep = new AstLte{fl, cexprp->cloneTree(false),
+                                                     newCaseSearchConst(cexprp, run.m_hi)};
+                    condp = condp ? new AstLogAnd{fl, condp, ltep} : ltep;
+                }
+            }
+            AstNode* const elsesp = m_caseDefaultp && m_caseDefaultp->stmtsp()
+                                        ? m_caseDefaultp->stmtsp()->cloneTree(true)
+                                        : nullptr;
+            return new AstIf{fl, condp, stmtsp, elsesp};
+        }
+        // Split at the middle run; the lower half is entirely below its first value
+        const size_t mid = first + (last - first + 1) / 2;
+        const uint64_t pivot = m_caseRuns[mid].m_lo;
+        AstNode* const lowerp = replaceCaseSearchRecurse(cexprp, first, mid - 1, lo, pivot - 1);
+        AstNode* const upperp = replaceCaseSearchRecurse(cexprp, mid, last, pivot, hi);
+        AstNode* const condp
+            = new AstLt{fl, cexprp->cloneTree(false), newCaseSearchConst(cexprp, pivot)};
+        return new AstIf{fl, condp, lowerp, upperp};
+    }
+
+    void replaceCaseSearch(AstCase* nodep) {
+        // CASE(cexpr, ITEM(c1,s1), ..., ITEM(cN,sN), ITEM(default,sD))  with sorted constants
+        // ->  IF(LT(cexpr, cM), IF(LT(cexpr, cL) ..., ...),
+        //                       ...
+        //                          IF(EQ(cexpr, cN), sN, sD))
+        AstNode* const cexprp = nodep->exprp()->unlinkFrBack();
+        // Handle any assertions
+        replaceCaseParallel(nodep, false);
+        const int width = cexprp->width();
+        const uint64_t hi = width == VL_QUADSIZE ? ~0ULL : ((1ULL << width) - 1);
+        AstNode* const ifrootp = replaceCaseSearchRecurse(cexprp, 0, m_caseRuns.size() - 1, 0, hi);
+        if (debug() >= 9 && ifrootp) ifrootp->dumpTree(cout, "    _search: ");
+        if (ifrootp) {
+            nodep->replaceWith(ifrootp);
+        } else {
+            nodep->unlinkFrBack();
+        }
+        VL_DO_DANGLING(nodep->deleteTree(), nodep);
+        VL_DO_DANGLING(cexprp->deleteTree(), cexprp);
+        m_caseRuns.clear();
+    }
+
     void replaceCaseComplicated(AstCase* nodep) {
         // CASEx(cexpr,ITEM(icond1,istmts1),ITEM(icond2,istmts2),ITEM(default,istmts3))
         // ->  IF((cexpr==icond1),istmts1,
@@ -505,8 +655,14 @@ private:
         } else {
             // If a case statement is whole, presume signals involved aren't forming a latch
             if (m_alwaysp) m_alwaysp->fileline()->warnOff(V3ErrorCode::LATCH, true);
-            ++m_statCaseSlow;
-            VL_DO_DANGLING(replaceCaseComplicated(nodep), nodep);
+            if (v3Global.opt.fCase() && isCaseTreeSearch(nodep)) {
+                // Many constant values, binary search them instead of comparing each in turn
+                ++m_statCaseSearch;
+                VL_DO_DANGLING(replaceCaseSearch(nodep), nodep);
+            } else {
+                ++m_statCaseSlow;
+                VL_DO_DANGLING(replaceCaseComplicated(nodep), nodep);
+            }
         }
     }
     //--------------------
@@ -524,6 +680,7 @@ public:
     ~CaseVisitor() override {
         V3Stats::addStat("Optimizations, Cases parallelized", m_statCaseFast);
         V3Stats::addStat("Optimizations, Cases complex", m_statCaseSlow);
+        V3Stats::addStat("Optimizations, Cases compare tree", m_statCaseSearch);
     }
 };
 
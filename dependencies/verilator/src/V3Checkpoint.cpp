@@ -0,0 +1,734 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Reuse of an elaborated netlist across runs
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2003-2022 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+// V3Checkpoint's Transformations:
+//
+// A run with --checkpoint-dir that gets through V3Width::widthCommit
+// without any message writes the elaborated netlist to a file in that
+// directory.  The file is named by a hash of the Verilator version,
+// working directory and frontend options (see V3Options::frontendArgs).
+// Ahead of the netlist it records what the frontend depended on:
+//      The value of each environment variable read (see V3Os::getenvReads)
+//      Each file looked for on the search paths, and whether it was found
+//          (see V3Options::fileProbes), so a new file on a -y or +incdir
+//          path is noticed
+//      The digest of each file read, including the Verilator executable
+//
+// A later run computes the same name before parsing.  If the file is
+// there and all of the above still hold, it loads the netlist and
+// continues with the backend passes; otherwise it parses as usual and
+// writes the file again.
+//
+// Nodes are written by code astgen generates from the data members of each
+// node class into V3Ast__gen_checkpoint.h.  Pointers to nodes and to
+// FileLines are written as numbers.  Storage for every node is allocated
+// before any is constructed, so each constructor can resolve its pointers.
+//
+//*************************************************************************
+
+#include "config_build.h"
+#include "verilatedos.h"
+
+#include "V3Checkpoint.h"
+
+#include "V3Ast.h"
+#include "V3Config.h"
+#include "V3File.h"
+#include "V3Global.h"
+#include "V3Os.h"
+#include "V3String.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+VL_DEFINE_DEBUG_FUNCTIONS;
+
+// Change when the layout of the file changes
+static constexpr const char* CHECKPOINT_MAGIC = "Verilator checkpoint 1\n";
+static constexpr size_t CHECKPOINT_DIGEST_SIZE = 32;  // Of VHashSha256::digestBinary
+
+// Generated into V3Ast__gen_checkpoint.h, included below
+static size_t checkpointNodeSize(VNType type);
+static AstNode* checkpointNodeNew(VNCheckpointReader& cp, VNType type, void* storagep);
+static void checkpointNodeWrite(VNCheckpointWriter& cp, const AstNode* nodep);
+
+static string fileDigest(const string& filename) {
+    std::ifstream ifs{filename, std::ios::binary};
+    if (!ifs) return "";
+    std::ostringstream oss;
+    oss << ifs.rdbuf();
+    return VHashSha256{oss.str()}.digestBinary();
+}
+
+//######################################################################
+// Netlist writer
+
+class VNCheckpointWriter final {
+    // MEMBERS
+    string m_out;  // Output being written
+    std::unordered_map<const AstNode*, uint32_t> m_nodeIds;  // Node number, 0 is nullptr
+    std::vector<const AstNode*> m_nodeps;  // Each node, by number less one
+    std::unordered_map<const FileLine*, uint32_t> m_fileLineIds;  // FileLine number, 0 is nullptr
+    std::vector<const FileLine*> m_fileLinesp;  // Each FileLine, by number less one
+    string m_whyNot;  // Why the netlist cannot be kept, if it cannot
+
+    // METHODS
+    void whyNot(const string& why) {
+        if (m_whyNot.empty()) m_whyNot = why;
+    }
+    void numberTree(const AstNode* rootp) {
+        // Iterative, as the tree may be deep
+        std::vector<const AstNode*> stack{rootp};
+        while (!stack.empty()) {
+            const AstNode* nodep = stack.back();
+            stack.pop_back();
+            for (; nodep; nodep = nodep->nextp()) {
+                m_nodeIds.emplace(nodep, m_nodeps.size() + 1);
+                m_nodeps.push_back(nodep);
+                if (nodep->op4p()) stack.push_back(nodep->op4p());
+                if (nodep->op3p()) stack.push_back(nodep->op3p());
+                if (nodep->op2p()) stack.push_back(nodep->op2p());
+                if (nodep->op1p()) stack.push_back(nodep->op1p());
+            }
+        }
+    }
+    uint32_t fileLineId(const FileLine* flp) {
+        if (!flp) return 0;
+        const auto pair = m_fileLineIds.emplace(flp, m_fileLinesp.size() + 1);
+        if (pair.second) m_fileLinesp.push_back(flp);
+        return pair.first->second;
+    }
+    void putInputs(const string& key) {
+        put(key);
+        put(V3Os::getenvReads());
+        put(v3Global.opt.fileProbes());
+        const std::vector<string> deps = V3File::getAllDeps();
+        put<uint64_t>(deps.size());
+        for (const string& filename : deps) {
+            put(filename);
+            put(fileDigest(filename));
+        }
+    }
+    void putGlobals() {
+        put(v3Global.widthMinUsage());
+        put(v3Global.assertDTypesResolved());
+        put(v3Global.assertScoped());
+        put(v3Global.constRemoveXs());
+        put(v3Global.needTraceDumper());
+        put(v3Global.dpi());
+        put(v3Global.hasEvents());
+        put(v3Global.hasClasses());
+        put(v3Global.usesTiming());
+        put(v3Global.hasForceableSignals());
+        put(v3Global.hasSCTextSections());
+        put(v3Global.useParallelBuild());
+        put(v3Global.useRandomizeMethods());
+        put(AstNodeDType::uniqueNum());
+        const std::vector<std::vector<string>>& settings = V3Config::backendSettings();
+        put<uint64_t>(settings.size());
+        for (const std::vector<string>& setting : settings) {
+            put<uint64_t>(setting.size());
+            for (const string& item : setting) put(item);
+        }
+    }
+    void putFileLines() {
+        // Number the parents too, which may add more to number
+        for (size_t i = 0; i < m_fileLinesp.size(); ++i) fileLineId(m_fileLinesp[i]->m_parent);
+        std::map<FileLineSingleton::fileNameIdx_t, uint32_t> fileIdxs;
+        std::vector<FileLineSingleton::fileNameIdx_t> filenamenos;
+        std::map<FileLineSingleton::msgEnSetIdx_t, uint32_t> msgEnIdxs;
+        std::vector<FileLineSingleton::msgEnSetIdx_t> msgEns;
+        std::unordered_map<const VFileContent*, uint32_t> contentIds;  // 0 is nullptr
+        std::vector<const VFileContent*> contentsp;
+        for (const FileLine* const flp : m_fileLinesp) {
+            if (fileIdxs.emplace(flp->m_filenameno, filenamenos.size()).second) {
+                filenamenos.push_back(flp->m_filenameno);
+            }
+            if (msgEnIdxs.emplace(flp->m_msgEnIdx, msgEns.size()).second) {
+                msgEns.push_back(flp->m_msgEnIdx);
+            }
+            if (flp->m_contentp
+                && contentIds.emplace(flp->m_contentp, contentsp.size() + 1).second) {
+                contentsp.push_back(flp->m_contentp);
+            }
+        }
+        const FileLineSingleton& singleton = FileLine::singleton();
+        put<uint64_t>(filenamenos.size());
+        for (const FileLineSingleton::fileNameIdx_t filenameno : filenamenos) {
+            put(singleton.numberToName(filenameno));
+            put(singleton.numberToLang(filenameno));
+        }
+        put<uint64_t>(msgEns.size());
+        for (const FileLineSingleton::msgEnSetIdx_t idx : msgEns) {
+            put(singleton.msgEn(idx).to_string());
+        }
+        put<uint64_t>(contentsp.size());
+        for (const VFileContent* const contentp : contentsp) {
+            put(contentp->m_mapp ? string{contentp->m_mapp.get(), contentp->m_mapSize}
+                                 : string{contentp->m_text.begin(), contentp->m_text.end()});
+        }
+        put<uint64_t>(m_fileLinesp.size());
+        for (const FileLine* const flp : m_fileLinesp) {
+            put(fileIdxs[flp->m_filenameno]);
+            put(msgEnIdxs[flp->m_msgEnIdx]);
+            put(static_cast<bool>(flp->m_waive));
+            put(static_cast<uint32_t>(flp->m_contentLineno));
+            put(flp->m_firstLineno);
+            put(flp->m_firstColumn);
+            put(flp->m_lastLineno);
+            put(flp->m_lastColumn);
+            put(flp->m_contentp ? contentIds[flp->m_contentp] : 0U);
+            put(static_cast<const FileLine*>(flp->m_parent));
+        }
+    }
+
+public:
+    // Numbers and enumerations
+    template <typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type
+    put(T value) {
+        m_out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    // Classes wrapping an enumeration
+    template <typename T>
+    typename std::enable_if<std::is_enum<decltype(T::m_e)>::value>::type put(const T& value) {
+        put(value.m_e);
+    }
+    void put(const string& value) {
+        put<uint64_t>(value.size());
+        m_out += value;
+    }
+    void put(const VNumRange& value) {
+        put(value.m_left);
+        put(value.m_right);
+        put(value.m_ranged);
+    }
+    void put(const VBasicTypeKey& value) {
+        put(value.m_width);
+        put(value.m_widthMin);
+        put(value.m_numeric);
+        put(value.m_keyword);
+        put(value.m_nrange);
+    }
+    void put(const AstBasicDType::Members& value) {
+        put(value.m_keyword);
+        put(value.m_nrange);
+    }
+    void put(const V3Number& value) {
+        const V3NumberData& data = value.m_data;
+        put(data.type());
+        put(data.width());
+        if (data.type() == V3NumberData::V3NumberDataType::STRING) {
+            put(data.str());
+        } else if (data.type() != V3NumberData::V3NumberDataType::UNINITIALIZED) {
+            for (int i = 0; i < (data.width() + 31) / 32; ++i) {
+                put(data.num()[i].m_value);
+                put(data.num()[i].m_valueX);
+            }
+        }
+        put(static_cast<bool>(data.m_sized));
+        put(static_cast<bool>(data.m_signed));
+        put(static_cast<bool>(data.m_isNull));
+        put(static_cast<bool>(data.m_fromString));
+        put(static_cast<bool>(data.m_autoExtend));
+        put(static_cast<const FileLine*>(value.m_fileline));
+    }
+    void put(const AstNode* nodep) {
+        if (!nodep) {
+            put(uint32_t{0});
+            return;
+        }
+        const auto it = m_nodeIds.find(nodep);
+        if (it == m_nodeIds.end()) {
+            whyNot("pointer to a node outside the netlist: " + nodep->prettyTypeName());
+            put(uint32_t{0});
+            return;
+        }
+        put(it->second);
+    }
+    void put(const FileLine* flp) { put(fileLineId(flp)); }
+    // Pointers to anything else are not kept; they must not be set yet
+    void put(const void* datap) {
+        if (datap) whyNot("node holds a pointer to a non-node object");
+        put(uint32_t{0});
+    }
+    template <typename K, typename V, typename C, typename A>
+    void put(const std::map<K, V, C, A>& value) {
+        put<uint64_t>(value.size());
+        for (const auto& itr : value) {
+            put(itr.first);
+            put(itr.second);
+        }
+    }
+    template <typename K, typename C, typename A>
+    void put(const std::set<K, C, A>& value) {
+        put<uint64_t>(value.size());
+        for (const auto& item : value) put(item);
+    }
+    template <typename K, typename V, typename H, typename P, typename A>
+    void put(const std::unordered_multimap<K, V, H, P, A>& value) {
+        put<uint64_t>(value.size());
+        for (const auto& itr : value) {
+            put(itr.first);
+            put(itr.second);
+        }
+    }
+    template <typename T, size_t N>
+    void putArray(const T (&value)[N]) {
+        for (const T& item : value) put(item);
+    }
+
+    // Compose the body of the checkpoint file, or return false and why not
+    bool write(const string& key, string& out) {
+        numberTree(v3Global.rootp());
+        // Nodes first, to learn the FileLines they use
+        for (const AstNode* const nodep : m_nodeps) checkpointNodeWrite(*this, nodep);
+        if (!m_whyNot.empty()) return false;
+        string nodes;
+        nodes.swap(m_out);
+        putInputs(key);
+        putGlobals();
+        put<uint64_t>(m_nodeps.size());
+        for (const AstNode* const nodep : m_nodeps) put(nodep->type());
+        putFileLines();
+        m_out += nodes;
+        out.swap(m_out);
+        return true;
+    }
+    const string& whyNot() const { return m_whyNot; }
+};
+
+//######################################################################
+// Netlist reader
+
+class VNCheckpointReader final {
+    // MEMBERS
+    const string& m_in;  // Input being read
+    size_t m_pos;  // Position in m_in
+    std::vector<string> m_deps;  // Files the frontend read
+    std::vector<void*> m_storagep;  // Storage of each node, by number less one
+    std::vector<FileLine*> m_fileLinesp;  // Each FileLine, by number less one
+
+    // METHODS
+    void readRaw(void* datap, size_t size) {
+        if (VL_UNCOVERABLE(size > m_in.size() - m_pos)) {
+            v3fatalSrc("Checkpoint ends early");  // LCOV_EXCL_LINE
+        }
+        std::memcpy(datap, m_in.data() + m_pos, size);
+        m_pos += size;
+    }
+    static void* allocate(size_t size) {
+#ifdef VL_LEAK_CHECKS
+        return AstNode::operator new(size);
+#else
+        return ::operator new(size);
+#endif
+    }
+
+    // Pointers are read by whether they point to a node, with a tag as some are incomplete
+    static std::true_type isNodePointer(const AstNode*);
+    static std::false_type isNodePointer(const void*);
+    template <typename T>
+    T* readPointer(std::true_type) {
+        const uint32_t id = take<uint32_t>();
+        if (!id) return nullptr;
+        if (VL_UNCOVERABLE(id > m_storagep.size())) {
+            v3fatalSrc("Checkpoint node number out of range");  // LCOV_EXCL_LINE
+        }
+        // Node classes only use single inheritance, so any base is at the same address
+        return reinterpret_cast<T*>(m_storagep[id - 1]);
+    }
+    template <typename T>
+    T* readPointer(std::false_type) {
+        if (VL_UNCOVERABLE(take<uint32_t>())) {
+            v3fatalSrc("Checkpoint holds a pointer to a non-node object");  // LCOV_EXCL_LINE
+        }
+        return nullptr;
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value, T>::type
+    read(T*) {
+        T value;
+        readRaw(&value, sizeof(value));
+        return value;
+    }
+    template <typename T>
+    typename std::enable_if<std::is_enum<decltype(T::m_e)>::value, T>::type read(T*) {
+        return T{take<decltype(T::m_e)>()};
+    }
+    string read(string*) {
+        const uint64_t size = take<uint64_t>();
+        if (VL_UNCOVERABLE(size > m_in.size() - m_pos)) {
+            v3fatalSrc("Checkpoint ends early");  // LCOV_EXCL_LINE
+        }
+        string value = m_in.substr(m_pos, size);
+        m_pos += size;
+        return value;
+    }
+    VNumRange read(VNumRange*) {
+        VNumRange value;
+        value.m_left = take<int>();
+        value.m_right = take<int>();
+        value.m_ranged = take<bool>();
+        return value;
+    }
+    VBasicTypeKey read(VBasicTypeKey*) {
+        // Braced, so read in order
+        return VBasicTypeKey{take<int>(), take<int>(), take<VSigning>(), take<VBasicDTypeKwd>(),
+                             take<VNumRange>()};
+    }
+    AstBasicDType::Members read(AstBasicDType::Members*) {
+        return AstBasicDType::Members{take<VBasicDTypeKwd>(), take<VNumRange>()};
+    }
+    V3Number read(V3Number*) {
+        using DataType = V3NumberData::V3NumberDataType;
+        V3Number num{static_cast<AstNode*>(nullptr)};
+        V3NumberData& data = num.m_data;
+        const DataType type = take<DataType>();
+        const int width = take<int>();
+        if (type == DataType::STRING) {
+            data.setString(take<string>());
+            data.resize(width);
+        } else if (type != DataType::UNINITIALIZED) {
+            if (type == DataType::DOUBLE) data.setDouble();
+            data.resize(width);
+            for (int i = 0; i < (width + 31) / 32; ++i) {
+                data.num()[i].m_value = take<uint32_t>();
+                data.num()[i].m_valueX = take<uint32_t>();
+            }
+        }
+        data.m_sized = take<bool>();
+        data.m_signed = take<bool>();
+        data.m_isNull = take<bool>();
+        data.m_fromString = take<bool>();
+        data.m_autoExtend = take<bool>();
+        num.m_fileline = take<FileLine*>();
+        return num;
+    }
+    FileLine* read(FileLine**) {
+        const uint32_t id = take<uint32_t>();
+        if (!id) return nullptr;
+        if (VL_UNCOVERABLE(id > m_fileLinesp.size())) {
+            v3fatalSrc("Checkpoint FileLine number out of range");  // LCOV_EXCL_LINE
+        }
+        return m_fileLinesp[id - 1];
+    }
+    template <typename T>
+    T* read(T**) {
+        return readPointer<T>(decltype(isNodePointer(static_cast<T*>(nullptr))){});
+    }
+    template <typename K, typename V, typename C, typename A>
+    std::map<K, V, C, A> read(std::map<K, V, C, A>*) {
+        std::map<K, V, C, A> value;
+        for (uint64_t n = take<uint64_t>(); n; --n) {
+            auto key = take<K>();
+            auto item = take<V>();
+            value.emplace(std::move(key), std::move(item));
+        }
+        return value;
+    }
+    template <typename K, typename C, typename A>
+    std::set<K, C, A> read(std::set<K, C, A>*) {
+        std::set<K, C, A> value;
+        for (uint64_t n = take<uint64_t>(); n; --n) value.emplace(take<K>());
+        return value;
+    }
+    template <typename K, typename V, typename H, typename P, typename A>
+    std::unordered_multimap<K, V, H, P, A> read(std::unordered_multimap<K, V, H, P, A>*) {
+        std::unordered_multimap<K, V, H, P, A> value;
+        for (uint64_t n = take<uint64_t>(); n; --n) {
+            auto key = take<K>();
+            auto item = take<V>();
+            value.emplace(std::move(key), std::move(item));
+        }
+        return value;
+    }
+
+    void getGlobals() {
+        v3Global.widthMinUsage(take<VWidthMinUsage>());
+        v3Global.assertDTypesResolved(take<bool>());
+        v3Global.assertScoped(take<bool>());
+        v3Global.constRemoveXs(take<bool>());
+        v3Global.needTraceDumper(take<bool>());
+        v3Global.dpi(take<bool>());
+        if (take<bool>()) v3Global.setHasEvents();
+        if (take<bool>()) v3Global.setHasClasses();
+        if (take<bool>()) v3Global.setUsesTiming();
+        if (take<bool>()) v3Global.setHasForceableSignals();
+        if (take<bool>()) v3Global.setHasSCTextSections();
+        v3Global.useParallelBuild(take<bool>());
+        v3Global.useRandomizeMethods(take<bool>());
+        AstNodeDType::uniqueNum(take<int>());
+        for (uint64_t n = take<uint64_t>(); n; --n) {
+            std::vector<string> setting;
+            for (uint64_t i = take<uint64_t>(); i; --i) setting.push_back(take<string>());
+            V3Config::backendSettingApply(setting);
+        }
+    }
+    void getFileLines() {
+        FileLineSingleton& singleton = FileLine::singleton();
+        std::vector<FileLineSingleton::fileNameIdx_t> filenamenos;
+        for (uint64_t n = take<uint64_t>(); n; --n) {
+            const FileLineSingleton::fileNameIdx_t filenameno
+                = singleton.nameToNumber(take<string>());
+            singleton.numberToLang(filenameno, take<V3LangCode>());
+            filenamenos.push_back(filenameno);
+        }
+        std::vector<FileLineSingleton::msgEnSetIdx_t> msgEns;
+        for (uint64_t n = take<uint64_t>(); n; --n) {
+            msgEns.push_back(
+                singleton.addMsgEnBitSet(FileLineSingleton::MsgEnBitSet{take<string>()}));
+        }
+        std::vector<VFileContent*> contentsp;
+        for (uint64_t n = take<uint64_t>(); n; --n) {
+            VFileContent* const contentp = new VFileContent;
+            contentp->pushText(take<string>());
+            contentsp.push_back(contentp);
+        }
+        // Allocate all first, as parents may come later
+        for (uint64_t n = take<uint64_t>(); n; --n) {
+            m_fileLinesp.push_back(new FileLine{FileLine::builtInFilename()});
+        }
+        for (FileLine* const flp : m_fileLinesp) {
+            flp->m_filenameno = filenamenos.at(take<uint32_t>());
+            flp->m_msgEnIdx = msgEns.at(take<uint32_t>());
+            flp->m_waive = take<bool>();
+            flp->m_contentLineno = take<uint32_t>();
+            flp->m_firstLineno = take<int>();
+            flp->m_firstColumn = take<int>();
+            flp->m_lastLineno = take<int>();
+            flp->m_lastColumn = take<int>();
+            if (const uint32_t contentId = take<uint32_t>()) {
+                flp->m_contentp = contentsp.at(contentId - 1);
+                flp->m_contentp->refInc();
+            }
+            flp->m_parent = take<FileLine*>();
+        }
+    }
+
+public:
+    // CONSTRUCTORS
+    VNCheckpointReader(const string& in, size_t pos)
+        : m_in{in}
+        , m_pos{pos} {}
+
+    // METHODS
+    // Read a value of the given type; see the matching VNCheckpointWriter::put
+    template <typename T>
+    typename std::remove_cv<T>::type take() {
+        return read(static_cast<typename std::remove_cv<T>::type*>(nullptr));
+    }
+    template <typename T, size_t N>
+    void getArray(T (&value)[N]) {
+        for (T& item : value) item = take<T>();
+    }
+
+    // Check the inputs recorded match this run, or return false and why not
+    bool inputsMatch(const string& key, string& whyNot) {
+        if (take<string>() != key) {
+            whyNot = "kept for other inputs of the same hash";
+            return false;
+        }
+        for (const auto& itr : take<std::map<string, string>>()) {
+            if (V3Os::getenvStr(itr.first, "") != itr.second) {
+                whyNot = "$" + itr.first + " changed";
+                return false;
+            }
+        }
+        for (const auto& itr : take<std::map<string, bool>>()) {
+            if (v3Global.opt.fileExists(itr.first).empty() == itr.second) {
+                whyNot = itr.first + (itr.second ? " was removed" : " was added");
+                return false;
+            }
+        }
+        for (uint64_t n = take<uint64_t>(); n; --n) {
+            const string filename = take<string>();
+            if (take<string>() != fileDigest(filename)) {
+                whyNot = filename + " changed";
+                return false;
+            }
+            m_deps.push_back(filename);
+        }
+        return true;
+    }
+    // Replace the netlist with the one kept
+    void load() {
+        for (const string& filename : m_deps) V3File::addSrcDepend(filename);
+        getGlobals();
+        std::vector<VNType> types;
+        for (uint64_t n = take<uint64_t>(); n; --n) {
+            const VNType type = take<VNType>();
+            const size_t size = checkpointNodeSize(type);
+            if (VL_UNCOVERABLE(!size)) {
+                v3fatalSrc("Checkpoint holds an unknown node type");  // LCOV_EXCL_LINE
+            }
+            types.push_back(type);
+            m_storagep.push_back(allocate(size));
+        }
+        getFileLines();
+        std::vector<AstNode*> nodesp;
+        for (size_t i = 0; i < types.size(); ++i) {
+            nodesp.push_back(checkpointNodeNew(*this, types[i], m_storagep[i]));
+        }
+        if (VL_UNCOVERABLE(m_pos != m_in.size() || nodesp.empty())) {
+            v3fatalSrc("Checkpoint does not end after the netlist");  // LCOV_EXCL_LINE
+        }
+        // V3Number's node is only for messages, and the node was not built when read
+        for (AstNode* const nodep : nodesp) {
+            if (AstConst* const constp = VN_CAST(nodep, Const)) constp->num().nodep(constp);
+        }
+        v3Global.rootp(VN_AS(nodesp.front(), Netlist));
+    }
+};
+
+//######################################################################
+// Node constructors and writers; AstNode's own, then generated for each node class
+
+AstNode::AstNode(VNType t, VNCheckpointReader& cp)
+    : m_nextp{cp.take<AstNode*>()}
+    , m_backp{cp.take<AstNode*>()}
+    , m_op1p{cp.take<AstNode*>()}
+    , m_op2p{cp.take<AstNode*>()}
+    , m_op3p{cp.take<AstNode*>()}
+    , m_op4p{cp.take<AstNode*>()}
+    , m_type{t}
+    , m_dtypep{cp.take<AstNodeDType*>()}
+    , m_headtailp{cp.take<AstNode*>()}
+    , m_fileline{cp.take<FileLine*>()} {
+    const uint8_t flags = cp.take<uint8_t>();
+    m_flags.didWidth = flags & 1;
+    m_flags.doingWidth = flags & 2;
+    m_flags.protect = flags & 4;
+    m_flags.unused = 0;
+    editCountInc();
+}
+
+void AstNode::checkpointWrite(VNCheckpointWriter& cp) const {
+    cp.put(m_nextp);
+    cp.put(m_backp);
+    cp.put(m_op1p);
+    cp.put(m_op2p);
+    cp.put(m_op3p);
+    cp.put(m_op4p);
+    cp.put(m_dtypep);
+    cp.put(m_headtailp);
+    cp.put(m_fileline);
+    cp.put(static_cast<uint8_t>((m_flags.didWidth ? 1 : 0) | (m_flags.doingWidth ? 2 : 0)
+                                | (m_flags.protect ? 4 : 0)));
+}
+
+#include "V3Ast__gen_checkpoint.h"
+
+//######################################################################
+// V3Checkpoint class functions
+
+static string checkpointKey() {
+    string key = "V3Checkpoint 1";
+    key += '\0';
+    key += V3Options::version();
+    key += '\0';
+    key += V3Os::filenameRealPath(".");
+    for (const string& arg : v3Global.opt.frontendArgs()) {
+        key += '\0';
+        key += arg;
+    }
+    return key;
+}
+
+static string checkpointFilename(const string& key) {
+    return v3Global.opt.checkpointDir() + "/" + VHashSha256{key}.digestHex().substr(0, 32)
+           + ".ckpt";
+}
+
+static string checkpointDigest(const string& contents, size_t pos) {
+    VHashSha256 hash;
+    hash.insert(contents.data() + pos, contents.size() - pos);
+    return hash.digestBinary();
+}
+
+bool V3Checkpoint::resume() {
+    const string key = checkpointKey();
+    const string filename = checkpointFilename(key);
+    std::ifstream ifs{filename, std::ios::binary};
+    if (!ifs) {
+        UINFO(1, "No checkpoint at " << filename << endl);
+        return false;
+    }
+    std::ostringstream oss;
+    oss << ifs.rdbuf();
+    const string contents = oss.str();
+    const size_t magicSize = std::strlen(CHECKPOINT_MAGIC);
+    const size_t headerSize = magicSize + CHECKPOINT_DIGEST_SIZE;
+    if (contents.size() < headerSize || contents.compare(0, magicSize, CHECKPOINT_MAGIC)
+        || contents.compare(magicSize, CHECKPOINT_DIGEST_SIZE,
+                            checkpointDigest(contents, headerSize))) {
+        UINFO(1, "Ignoring unreadable checkpoint " << filename << endl);
+        return false;
+    }
+    VNCheckpointReader reader{contents, headerSize};
+    string whyNot;
+    if (!reader.inputsMatch(key, whyNot)) {
+        UINFO(1, "Not resuming from checkpoint " << filename << ": " << whyNot << endl);
+        return false;
+    }
+    UINFO(1, "Resuming from checkpoint " << filename << endl);
+    reader.load();
+    V3Global::dumpCheckGlobalTree("checkpoint", 0, dumpTree() >= 3);
+    return true;
+}
+
+void V3Checkpoint::checkpoint() {
+    const string key = checkpointKey();
+    const string filename = checkpointFilename(key);
+    // A resumed run could not repeat the messages
+    if (V3Error::errorCount() || V3Error::warnCount()) {
+        UINFO(1, "Not writing checkpoint " << filename << " after messages" << endl);
+        return;
+    }
+    VNCheckpointWriter writer;
+    string body;
+    if (!writer.write(key, body)) {
+        UINFO(1, "Not writing checkpoint " << filename << ": " << writer.whyNot() << endl);
+        return;
+    }
+    const string digest = VHashSha256{body}.digestBinary();
+    // Written aside and renamed, so a concurrent run reads the old or new file whole
+    V3Os::createDir(v3Global.opt.checkpointDir());
+    const string tmpFilename = filename + "." + VHashSha256{digest}.digestHex().substr(0, 8);
+    {
+        std::ofstream ofs{tmpFilename, std::ios::binary | std::ios::trunc};
+        ofs << CHECKPOINT_MAGIC << digest << body;
+        if (!ofs) {
+            UINFO(1, "Cannot write checkpoint " << tmpFilename << endl);
+            ofs.close();
+            std::remove(tmpFilename.c_str());
+            return;
+        }
+    }
+    if (std::rename(tmpFilename.c_str(), filename.c_str())) {
+        UINFO(1, "Cannot rename checkpoint " << tmpFilename << endl);
+        std::remove(tmpFilename.c_str());
+        return;
+    }
+    UINFO(1, "Wrote checkpoint " << filename << endl);
+}
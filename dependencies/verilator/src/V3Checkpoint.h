@@ -0,0 +1,34 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Reuse of an elaborated netlist across runs
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2003-2022 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+
+#ifndef VERILATOR_V3CHECKPOINT_H_
+#define VERILATOR_V3CHECKPOINT_H_
+
+#include "config_build.h"
+#include "verilatedos.h"
+
+//============================================================================
+
+class V3Checkpoint final {
+public:
+    // Instead of parsing, load the netlist a checkpoint kept for the same inputs.
+    // Returns false, leaving the netlist alone, if there is no usable checkpoint.
+    static bool resume();
+    // After elaboration, keep the netlist for later runs with the same inputs
+    static void checkpoint();
+};
+
+#endif  // Guard
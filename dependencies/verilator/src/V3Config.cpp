@@ -46,6 +46,11 @@ public:
     V3ConfigWildcardResolver() = default;
     ~V3ConfigWildcardResolver() = default;
 
+    void clear() {
+        m_mapWildcard.clear();
+        m_mapResolved.clear();
+    }
+
     /// Update into maps from other
     void update(const V3ConfigWildcardResolver& other) {
         for (const auto& itr : other.m_mapResolved) m_mapResolved[itr.first].update(itr.second);
@@ -387,6 +392,10 @@ class V3ConfigScopeTraceResolver final {
     std::map<V3ConfigScopeTraceEntryMatch, bool> m_matchCache;  // Matching entries for speed
 
 public:
+    void clear() {
+        m_entries.clear();
+        m_matchCache.clear();
+    }
     void addScopeTraceOn(bool on, const string& scope, int levels) {
         UINFO(9, "addScopeTraceOn " << on << " '" << scope << "' "
                                     << " levels=" << levels << endl);
@@ -450,6 +459,7 @@ class V3ConfigResolver final {
     std::unordered_map<string, std::unordered_map<string, uint64_t>>
         m_profileData;  // Access to profile_data records
     FileLine* m_profileFileLine = nullptr;
+    std::vector<std::vector<string>> m_backendSettings;  // See V3Config::backendSettings
 
     V3ConfigResolver() = default;
     ~V3ConfigResolver() = default;
@@ -459,6 +469,14 @@ public:
         static V3ConfigResolver s_singleton;
         return s_singleton;
     }
+    void reset() {
+        m_modules.clear();
+        m_files.clear();
+        m_scopeTraces.clear();
+        m_profileData.clear();
+        m_profileFileLine = nullptr;
+        m_backendSettings.clear();
+    }
     V3ConfigModuleResolver& modules() { return m_modules; }
     V3ConfigFileResolver& files() { return m_files; }
     V3ConfigScopeTraceResolver& scopeTraces() { return m_scopeTraces; }
@@ -476,6 +494,7 @@ public:
         return it->second;
     }
     FileLine* getProfileDataFileLine() const { return m_profileFileLine; }  // Maybe null
+    std::vector<std::vector<string>>& backendSettings() { return m_backendSettings; }
 };
 
 //######################################################################
@@ -528,10 +547,14 @@ void V3Config::addModulePragma(const string& module, VPragmaType pragma) {
 
 void V3Config::addProfileData(FileLine* fl, const string& model, const string& key,
                               uint64_t cost) {
+    V3ConfigResolver::s().backendSettings().push_back(
+        {"profile_data", fl->filename(), cvtToStr(fl->lineno()), model, key, cvtToStr(cost)});
     V3ConfigResolver::s().addProfileData(fl, model, key, cost);
 }
 
 void V3Config::addScopeTraceOn(bool on, const string& scope, int levels) {
+    V3ConfigResolver::s().backendSettings().push_back(
+        {"tracing", on ? "1" : "0", scope, cvtToStr(levels)});
     V3ConfigResolver::s().scopeTraces().addScopeTraceOn(on, scope, levels);
 }
 
@@ -583,6 +606,7 @@ void V3Config::addVarAttr(FileLine* fl, const string& module, const string& ftas
 }
 
 void V3Config::addWaiver(V3ErrorCode code, const string& filename, const string& message) {
+    V3ConfigResolver::s().backendSettings().push_back({"waive", code.ascii(), filename, message});
     V3ConfigResolver::s().files().at(filename).addWaiver(code, message);
 }
 
@@ -650,3 +674,24 @@ bool V3Config::waive(FileLine* filelinep, V3ErrorCode code, const string& messag
     if (!filep) return false;
     return filep->waive(code, message);
 }
+
+const std::vector<std::vector<string>>& V3Config::backendSettings() {
+    return V3ConfigResolver::s().backendSettings();
+}
+
+void V3Config::backendSettingApply(const std::vector<string>& setting) {
+    // Inverse of the records made by addProfileData, addScopeTraceOn and addWaiver
+    if (setting.size() == 6 && setting[0] == "profile_data") {
+        FileLine* const fl = new FileLine{setting[1]};
+        fl->lineno(std::stoi(setting[2]));
+        addProfileData(fl, setting[3], setting[4], std::stoull(setting[5]));
+    } else if (setting.size() == 4 && setting[0] == "tracing") {
+        addScopeTraceOn(setting[1] == "1", setting[2], std::stoi(setting[3]));
+    } else if (setting.size() == 4 && setting[0] == "waive") {
+        addWaiver(V3ErrorCode{setting[1].c_str()}, setting[2], setting[3]);
+    } else {
+        v3fatalSrc("Unknown backend setting: " << (setting.empty() ? "" : setting[0]));
+    }
+}
+
+void V3Config::reset() { V3ConfigResolver::s().reset(); }
@@ -53,6 +53,12 @@ public:
     static FileLine* getProfileDataFileLine();
     static bool getScopeTraceOn(const string& scope);
     static bool waive(FileLine* filelinep, V3ErrorCode code, const string& message);
+
+    // Settings used after elaboration, as strings to keep with --checkpoint-dir
+    static const std::vector<std::vector<string>>& backendSettings();
+    static void backendSettingApply(const std::vector<string>& setting);
+
+    static void reset();  // Forget all configuration, to Verilate again
 };
 
 #endif  // Guard
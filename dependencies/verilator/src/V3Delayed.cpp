@@ -46,6 +46,18 @@
 //      ...
 //      ASSIGNW (BITSEL(ARRAYSEL(VARREF(x), __Vdlyvdim_x), __Vdlyvlsb_x), __Vdlyvval_x)
 //
+// Unpacked arrays written from loops, or from many assignments, only as whole elements:
+// ASSIGNDLY (ARRAYSEL (VARREF(x), index), rhs)
+// ->   VAR __VdlyCommitQueue__x
+//      CMETHODHARD(__VdlyCommitQueue__x, enqueue, rhs, index)
+//      ...
+//      ALWAYSPOST: CMETHODHARD(__VdlyCommitQueue__x, commit, VARREF(x))
+// With --threads, each process writing x has its own queue, as processes may
+// run in parallel; the queues are committed one after another in the order
+// they were created:
+//      ALWAYSPOST: CMETHODHARD(__VdlyCommitQueue__x, commit, VARREF(x))
+//                  CMETHODHARD(__VdlyCommitQueue__x__1, commit, VARREF(x))
+//
 //*************************************************************************
 
 #include "config_build.h"
@@ -60,9 +72,95 @@
 #include <algorithm>
 #include <deque>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 
 VL_DEFINE_DEBUG_FUNCTIONS;
 
+// Delayed writes to an array from at least this many assignments use a commit queue
+#define DELAYED_QUEUE_MIN_SITES 8
+
+//######################################################################
+// Find the arrays whose delayed assignments are committed via a VlNBACommitQueue
+
+class DelayedQueueVisitor final : public VNVisitor {
+private:
+    // TYPES
+    struct Sites final {
+        int m_count = 0;  // Number of delayed assignments
+        bool m_inLoop = false;  // Some assignment is in a loop
+        bool m_queueable = true;  // All assignments can use a commit queue
+    };
+
+    // STATE
+    AstNodeProcedure* m_procp = nullptr;  // Current process
+    bool m_inLoop = false;  // True in loops
+    std::unordered_map<const AstVarScope*, Sites> m_sites;  // Delayed assignments per array
+    std::unordered_set<const AstVarScope*>& m_queuedps;  // Result
+
+    // METHODS
+    static bool isQueueableArray(const AstVarScope* vscp) {
+        // One dimensional unpacked arrays of packed elements
+        const AstUnpackArrayDType* const adtypep
+            = VN_CAST(vscp->dtypep()->skipRefp(), UnpackArrayDType);
+        if (!adtypep) return false;
+        const AstNodeDType* const subp = adtypep->subDTypep()->skipRefp();
+        return !VN_IS(subp, UnpackArrayDType) && subp->basicp() && !subp->basicp()->isOpaque();
+    }
+
+    // VISITORS
+    void visit(AstNodeProcedure* nodep) override {
+        VL_RESTORER(m_procp);
+        m_procp = nodep;
+        iterateChildren(nodep);
+    }
+    void visit(AstWhile* nodep) override {
+        VL_RESTORER(m_inLoop);
+        m_inLoop = true;
+        iterateChildren(nodep);
+    }
+    void visit(AstAssignDly* nodep) override {
+        const AstNode* fromp = nodep->lhsp();
+        while (true) {
+            if (const AstSel* const selp = VN_CAST(fromp, Sel)) {
+                fromp = selp->fromp();
+            } else if (const AstArraySel* const selp = VN_CAST(fromp, ArraySel)) {
+                fromp = selp->fromp();
+            } else {
+                break;
+            }
+        }
+        const AstVarRef* const refp = VN_CAST(fromp, VarRef);
+        if (!refp) return;
+        Sites& sites = m_sites[refp->varScopep()];
+        ++sites.m_count;
+        if (m_inLoop) sites.m_inLoop = true;
+        // Only whole element writes, with a 32 bit index, from non-suspendable processes
+        const AstArraySel* const selp = VN_CAST(nodep->lhsp(), ArraySel);
+        if (!selp || selp->fromp() != refp || selp->bitp()->width() > VL_IDATASIZE
+            || (m_procp && m_procp->isSuspendable()) || !isQueueableArray(refp->varScopep())) {
+            sites.m_queueable = false;
+        }
+    }
+    void visit(AstNodeMath*) override {}  // Accelerate
+    void visit(AstNode* nodep) override { iterateChildren(nodep); }
+
+public:
+    // CONSTRUCTORS
+    DelayedQueueVisitor(AstNetlist* nodep, std::unordered_set<const AstVarScope*>& queuedps)
+        : m_queuedps(queuedps) {
+        iterate(nodep);
+        for (const auto& pair : m_sites) {
+            const Sites& sites = pair.second;
+            if (sites.m_queueable
+                && (sites.m_inLoop || sites.m_count >= DELAYED_QUEUE_MIN_SITES)) {
+                m_queuedps.insert(pair.first);
+            }
+        }
+    }
+    ~DelayedQueueVisitor() override = default;
+};
+
 //######################################################################
 // Delayed state, as a visitor of each AstNode
 
@@ -105,7 +203,12 @@ private:
     using VarMap = std::map<const std::pair<AstNodeModule*, std::string>, AstVar*>;
     VarMap m_modVarMap;  // Table of new var names created under module
     VDouble0 m_statSharedSet;  // Statistic tracking
+    VDouble0 m_statCommitQueues;  // Statistic tracking
     std::unordered_map<const AstVarScope*, int> m_scopeVecMap;  // Next var number for each scope
+    std::unordered_set<const AstVarScope*> m_queuedps;  // Arrays written via a commit queue
+    // Commit queue for each array in m_queuedps and, with --threads, each writing process
+    std::map<std::pair<const AstVarScope*, const AstNodeProcedure*>, AstVarScope*> m_queueVscps;
+    std::unordered_map<const AstVarScope*, int> m_queueCounts;  // Queues of each array
 
     // METHODS
 
@@ -408,6 +511,64 @@ private:
         return newlhsp;
     }
 
+    void createDlyQueue(AstAssignDly* nodep) {
+        // Replace delayed assignment with an append to the commit queue of the array
+        // See top of this file for transformation
+        FileLine* const flp = nodep->fileline();
+        AstArraySel* const arrayselp = VN_AS(nodep->lhsp(), ArraySel);
+        AstVarRef* const varrefp = VN_AS(arrayselp->fromp(), VarRef);
+        AstVarScope* const vscp = varrefp->varScopep();
+        // The queues are not locked, so with --threads one per writing process
+        const AstNodeProcedure* const procp = v3Global.opt.mtasks() ? m_procp : nullptr;
+        AstVarScope*& queuevscp = m_queueVscps[std::make_pair(vscp, procp)];
+        if (!queuevscp) {  // First time we've dealt with this memory, or process
+            UINFO(4, "AssignDlyQueue: " << nodep << endl);
+            ++m_statCommitQueues;
+            // The queue type is parameterized by the width of the elements
+            const int width = arrayselp->dtypep()->width();
+            AstBasicDType* const dtypep = new AstBasicDType{
+                flp, VBasicDTypeKwd::NBA_COMMIT_QUEUE, VSigning::UNSIGNED, width, width};
+            v3Global.rootp()->typeTablep()->addTypesp(dtypep);
+            const int queueNum = m_queueCounts[vscp]++;
+            queuevscp = createVarSc(vscp,
+                                    "__VdlyCommitQueue__" + vscp->varp()->shortName()
+                                        + (queueNum ? "__" + cvtToStr(queueNum) : ""),
+                                    0, dtypep);
+            // Not a BLOCKTEMP, so it is not localized, and keeps its storage across evaluations
+            queuevscp->varp()->varType(VVarType::MODULETEMP);
+            // Commit the queue in the array's ALWAYSPOST; commit empties the queue
+            AstVarRef* const arrayrefp = new AstVarRef{flp, vscp, VAccess::WRITE};
+            arrayrefp->user2(true);  // Don't detect this assignment
+            AstCMethodHard* const commitp = new AstCMethodHard{
+                flp, new AstVarRef{flp, queuevscp, VAccess::READWRITE}, "commit", arrayrefp};
+            commitp->dtypeSetVoid();
+            commitp->statement(true);
+            if (AstAlwaysPost* const finalp = VN_CAST(vscp->user4p(), AlwaysPost)) {
+                checkActivePost(varrefp, VN_AS(finalp->user2p(), Active));
+                finalp->addStmtsp(commitp);
+            } else {
+                AstAlwaysPost* const newfinalp = new AstAlwaysPost{flp, nullptr, nullptr};
+                newfinalp->addStmtsp(commitp);
+                AstActive* const newactp = createActive(varrefp);
+                newactp->addStmtsp(newfinalp);
+                vscp->user4p(newfinalp);
+                newfinalp->user2p(newactp);
+            }
+        } else {
+            AstAlwaysPost* const finalp = VN_AS(vscp->user4p(), AlwaysPost);
+            checkActivePost(varrefp, VN_AS(finalp->user2p(), Active));
+        }
+        AstNode* const valuep = nodep->rhsp()->unlinkFrBack();
+        AstNode* const indexp = arrayselp->bitp()->unlinkFrBack();
+        AstCMethodHard* const enqueuep = new AstCMethodHard{
+            flp, new AstVarRef{flp, queuevscp, VAccess::WRITE}, "enqueue", valuep};
+        enqueuep->addPinsp(indexp);
+        enqueuep->dtypeSetVoid();
+        enqueuep->statement(true);
+        nodep->replaceWith(enqueuep);
+        VL_DO_DANGLING(pushDeletep(nodep), nodep);
+    }
+
     // VISITORS
     void visit(AstNetlist* nodep) override {
         // VV*****  We reset all userp() on the netlist
@@ -518,7 +679,12 @@ private:
         const bool isArray = VN_IS(nodep->lhsp(), ArraySel)
                              || (VN_IS(nodep->lhsp(), Sel)
                                  && VN_IS(VN_AS(nodep->lhsp(), Sel)->fromp(), ArraySel));
-        if (m_procp->isSuspendable() || isArray) {
+        const AstArraySel* const arrayselp = VN_CAST(nodep->lhsp(), ArraySel);
+        const AstVarRef* const queuedrefp
+            = arrayselp ? VN_CAST(arrayselp->fromp(), VarRef) : nullptr;
+        if (queuedrefp && m_queuedps.count(queuedrefp->varScopep())) {
+            VL_DO_DANGLING(createDlyQueue(nodep), nodep);
+        } else if (m_procp->isSuspendable() || isArray) {
             AstNode* const lhsp = nodep->lhsp();
             AstNode* const newlhsp = createDlyOnSet(nodep, lhsp);
             if (m_inLoop && isArray) {
@@ -619,9 +785,13 @@ private:
 
 public:
     // CONSTRUCTORS
-    explicit DelayedVisitor(AstNetlist* nodep) { iterate(nodep); }
+    explicit DelayedVisitor(AstNetlist* nodep) {
+        if (v3Global.opt.fNbaQueue()) DelayedQueueVisitor{nodep, m_queuedps};
+        iterate(nodep);
+    }
     ~DelayedVisitor() override {
         V3Stats::addStat("Optimizations, Delayed shared-sets", m_statSharedSet);
+        V3Stats::addStat("Optimizations, Delayed commit queues", m_statCommitQueues);
     }
 };
 
@@ -690,6 +690,8 @@ string EmitCFunc::emitVarResetRecurse(const AstVar* varp, const string& varNameP
         return "";
     } else if (basicp && basicp->isForkSync()) {
         return "";
+    } else if (basicp && basicp->isNbaCommitQueue()) {
+        return "";
     } else if (basicp && basicp->isDelayScheduler()) {
         return "";
     } else if (basicp && basicp->isTriggerScheduler()) {
@@ -30,6 +30,8 @@
 
 VL_DEFINE_DEBUG_FUNCTIONS;
 
+#define TRACE_VECTOR_MIN_ELEMENTS 8  // Minimum array elements to compare in blocks when tracing
+
 //######################################################################
 // Visitor that gathers the headers required by an AstCFunc
 
@@ -384,6 +386,8 @@ class EmitCImp final : EmitCFunc {
                         } else if (varp->isParam()) {
                         } else if (varp->isStatic() && varp->isConst()) {
                         } else if (varp->basicp() && varp->basicp()->isTriggerVec()) {
+                        } else if (varp->basicp() && varp->basicp()->isNbaCommitQueue()) {
+                            // Always empty between evaluations
                         } else {
                             int vects = 0;
                             AstNodeDType* elementp = varp->dtypeSkipRefp();
@@ -794,6 +798,52 @@ class EmitCTrace final : EmitCFunc {
         puts(");\n");
     }
 
+    bool emitTraceIsVector(AstTraceInc* nodep) {
+        // Simple arrays held contiguously in the model are compared a block at a time
+        // by the runtime, rather than unrolled into a change check per element
+        if (!v3Global.opt.fTraceVector() || nodep->full() || v3Global.opt.useTraceOffload()) {
+            return false;
+        }
+        if (nodep->declp()->arrayRange().elements() < TRACE_VECTOR_MIN_ELEMENTS) return false;
+        if (nodep->dtypep()->basicp()->isDouble()) return false;
+        const AstVarRef* const varrefp = VN_CAST(nodep->valuep(), VarRef);
+        return varrefp && !varrefp->varp()->isSc();
+    }
+
+    void emitTraceChangeVector(AstTraceInc* nodep) {
+        iterateAndNextNull(nodep->precondsp());
+        bool emitWidth = true;
+        if (nodep->isWide()) {
+            puts("bufp->chgWDataArray");
+        } else if (nodep->isQuad()) {
+            puts("bufp->chgQDataArray");
+        } else if (nodep->declp()->widthMin() > 16) {
+            puts("bufp->chgIDataArray");
+        } else if (nodep->declp()->widthMin() > 8) {
+            puts("bufp->chgSDataArray");
+        } else if (nodep->declp()->widthMin() > 1) {
+            puts("bufp->chgCDataArray");
+        } else {
+            puts("bufp->chgBitArray");
+            emitWidth = false;
+        }
+        puts("(oldp+");
+        puts(cvtToStr(nodep->declp()->code() - nodep->baseCode()));
+        puts(",");
+        // Elements are stored back to back, so pass a pointer to the first
+        if (nodep->isWide()) {
+            iterate(nodep->valuep());
+            puts("[0].data()");
+        } else {
+            puts("&(");
+            iterate(nodep->valuep());
+            puts("[0])");
+        }
+        puts("," + cvtToStr(nodep->declp()->arrayRange().elements()));
+        if (emitWidth) puts("," + cvtToStr(nodep->declp()->widthMin()));
+        puts(");\n");
+    }
+
     void emitTraceValue(AstTraceInc* nodep, int arrayindex) {
         if (AstVarRef* const varrefp = VN_CAST(nodep->valuep(), VarRef)) {
             AstVar* const varp = varrefp->varp();
@@ -869,7 +919,9 @@ class EmitCTrace final : EmitCFunc {
         }
     }
     void visit(AstTraceInc* nodep) override {
-        if (nodep->declp()->arrayRange().ranged()) {
+        if (nodep->declp()->arrayRange().ranged() && emitTraceIsVector(nodep)) {
+            emitTraceChangeVector(nodep);
+        } else if (nodep->declp()->arrayRange().ranged()) {
             // It traces faster if we unroll the loop
             for (int i = 0; i < nodep->declp()->arrayRange().elements(); i++) {
                 emitTraceChangeOne(nodep, i);
@@ -150,6 +150,8 @@ private:
             return "";
         } else if (basicp && basicp->isForkSync()) {
             return "";
+        } else if (basicp && basicp->isNbaCommitQueue()) {
+            return "";
         } else if (basicp && basicp->isDelayScheduler()) {
             return "";
         } else if (basicp && basicp->isTriggerScheduler()) {
@@ -114,6 +114,7 @@ class EmitCSyms final : EmitCBaseVisitor {
 
     // METHODS
     void emitSymHdr();
+    void emitPchHdr();
     void checkSplit(bool usesVfinal);
     void closeSplit();
     void emitSymImpPreamble();
@@ -276,6 +277,7 @@ class EmitCSyms final : EmitCBaseVisitor {
             // Must emit implementation first to determine number of splits
             emitSymImp();
             emitSymHdr();
+            if (v3Global.opt.pch()) emitPchHdr();
         }
         if (v3Global.dpi()) {
             emitDpiHdr();
@@ -584,6 +586,36 @@ void EmitCSyms::checkSplit(bool usesVfinal) {
     puts(") {\n");
 }
 
+void EmitCSyms::emitPchHdr() {
+    UINFO(6, __FUNCTION__ << ": " << endl);
+    const string filename = v3Global.opt.makeDir() + "/" + topClassName() + "__pch.h";
+    AstCFile* const cfilep = newCFile(filename, false /*slow*/, false /*source*/);
+    cfilep->support(true);
+
+    V3OutCFile* const ofp = v3Global.opt.systemC() ? new V3OutScFile{filename}
+                                                   : new V3OutCFile{filename};
+    m_ofp = ofp;
+
+    ofp->putsHeader();
+    puts("// DESCR"
+         "IPTION: Verilator output: Precompiled header\n");
+    puts("//\n");
+    puts("// Internal details; the generated makefiles precompile this header and\n");
+    puts("// include it ahead of each Verilated .cpp file (from --pch).\n");
+
+    ofp->putsGuard();
+
+    puts("\n");
+    ofp->putsIntTopInclude();
+    puts("#include \"verilated.h\"\n");
+    if (v3Global.dpi()) puts("#include \"verilated_dpi.h\"\n");
+    if (v3Global.opt.coverage()) puts("#include \"verilated_cov.h\"\n");
+    puts("\n#include \"" + symClassName() + ".h\"\n");
+
+    ofp->putsEndGuard();
+    VL_DO_CLEAR(delete m_ofp, m_ofp = nullptr);
+}
+
 void EmitCSyms::emitSymImpPreamble() {
     ofp()->putsHeader();
     puts("// DESCR"
@@ -733,23 +765,12 @@ void EmitCSyms::emitSymImp() {
     puts("    , __Vm_modelp{modelp}\n");
 
     if (v3Global.opt.mtasks()) {
-        // TODO -- For now each model creates its own ThreadPool here,
-        // and deletes it in the destructor. If A and B are each top level
-        // modules, each creates a separate thread pool.  This allows
-        // A.eval() and B.eval() to run concurrently without any
-        // interference -- so long as the physical machine has enough cores
-        // to support both pools and all testbench threads.
-        //
-        // In the future, we might want to let the client provide a
-        // threadpool to the constructor. This would allow two or more
-        // models to share a single threadpool.
-        //
-        // For example: suppose models A and B are each compiled to run on
-        // 4 threads. The client might create a single thread pool with 3
-        // threads and pass it to both models. If the client can ensure that
-        // A.eval() and B.eval() do NOT run concurrently, there will be no
-        // contention for the threads. This mode is missing for now.  (Is
-        // there demand for such a setup?)
+        // The thread pool belongs to the context, and is shared by all
+        // models in the context. The client may also create a single pool
+        // with VerilatedContext::newThreadPool() and pass it to several
+        // contexts with VerilatedContext::threadPool(). A.eval() and
+        // B.eval() of models sharing a pool may still run concurrently;
+        // VlThreadPool::dispatch() interleaves their mtasks on the workers.
         //
         // Note we create N-1 threads in the thread pool. The thread
         // that calls eval() becomes the final Nth thread for the
@@ -63,6 +63,10 @@ public:
         of.puts("VM_PARALLEL_BUILDS = ");
         of.puts(v3Global.useParallelBuild() ? "1" : "0");
         of.puts("\n");
+        of.puts("# Precompiled headers?  0/1 (from --pch)\n");
+        of.puts("VM_PCH = ");
+        of.puts(v3Global.opt.pch() ? "1" : "0");
+        of.puts("\n");
         of.puts("# Threaded output mode?  0/1/N threads (from --threads)\n");
         of.puts("VM_THREADS = ");
         of.puts(cvtToStr(v3Global.opt.threads()));
@@ -0,0 +1,681 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Emit SMT-LIB transition relation
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2003-2022 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+// V3EmitSmt's Transformations:
+//
+// For --smt2, before scheduling, write the transition relation of one
+// rising edge of the clocks as SMT-LIB bit-vector terms:
+//      Clocks are high, as --sym-exec-main sets them before evaluating
+//      Declare the inputs, and the current value of each variable
+//          written by clocked logic or read before it is written
+//      Evaluate the combinational logic the clocked logic reads,
+//          each block on demand after the blocks writing what it reads
+//      Evaluate the clocked logic: the V3Delayed pre assignments,
+//          the always blocks, then the post assignments
+//      Evaluate the combinational logic the outputs read again
+//      Each assignment defines a new constant, branches of an if are
+//          merged with ite
+//      Define <name>__next for each state variable and output
+//
+//*************************************************************************
+
+#include "config_build.h"
+#include "verilatedos.h"
+
+#include "V3EmitSmt.h"
+
+#include "V3Ast.h"
+#include "V3File.h"
+#include "V3Global.h"
+#include "V3Stats.h"
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+VL_DEFINE_DEBUG_FUNCTIONS;
+
+//######################################################################
+// A logic block, and the variables it references
+
+class EmitSmtBlock final {
+public:
+    AstNode* const m_nodep;  // AstAlways, AstAssignW etc.
+    std::vector<AstVarScope*> m_refps;  // Variables read or written
+    std::vector<AstVarScope*> m_writeps;  // Variables written
+    explicit EmitSmtBlock(AstNode* nodep)
+        : m_nodep{nodep} {
+        std::unordered_set<AstVarScope*> refs;
+        std::unordered_set<AstVarScope*> writes;
+        nodep->foreach([&](AstVarRef* refp) {
+            AstVarScope* const vscp = refp->varScopep();
+            UASSERT_OBJ(vscp, refp, "Not linked");
+            if (refs.insert(vscp).second) m_refps.push_back(vscp);
+            if (refp->access().isWriteOrRW() && writes.insert(vscp).second) {
+                m_writeps.push_back(vscp);
+            }
+        });
+    }
+};
+
+//######################################################################
+// Build the transition relation
+
+class EmitSmtVisitor final : public VNVisitor {
+    // TYPES
+    enum State : uint8_t { UNDONE, EVALUATING, DONE };
+    static constexpr size_t NONE = ~static_cast<size_t>(0);
+
+    // STATE
+    std::vector<EmitSmtBlock> m_combBlocks;  // Combinational logic
+    std::vector<State> m_combStates;  // Evaluation state of each of m_combBlocks
+    std::unordered_map<AstVarScope*, std::vector<size_t>> m_writers;  // Comb blocks writing var
+    std::vector<AstActive*> m_clockedps;  // Clocked logic
+    std::vector<AstVarScope*> m_inputps;  // Top level inputs, in declaration order
+    std::vector<AstVarScope*> m_outputps;  // Top level outputs, in declaration order
+    std::vector<AstVarScope*> m_stateps;  // Declared current values, in declaration order
+    std::unordered_map<AstVarScope*, string> m_values;  // Current term of each variable
+    // Variables assigned in the current block and their previous terms, "" if none,
+    // to restore at the end of a branch
+    std::vector<std::pair<AstVarScope*, string>> m_undo;
+    size_t m_combIdx = NONE;  // Combinational block being evaluated
+    bool m_combDemand = false;  // Evaluate comb blocks writing a variable when it is read
+    string m_term;  // Term of the expression last visited
+    std::ostringstream m_defs;  // Definitions of intermediate terms
+    int m_tmpNum = 0;  // Number of the last intermediate term
+    bool m_failed = false;  // Reported an error, stop translating
+    VDouble0 m_statDefs;  // Statistic tracking
+
+    // METHODS
+    void unsupported(AstNode* nodep, const string& why) {
+        if (m_failed) return;
+        m_failed = true;
+        nodep->v3warn(E_UNSUPPORTED, "Unsupported: --smt2: " << why);
+    }
+
+    static string sort(int width) { return "(_ BitVec " + cvtToStr(width) + ")"; }
+    static string zero(int width) { return "(_ bv0 " + cvtToStr(width) + ")"; }
+    static string ones(int width) { return "(bvnot " + zero(width) + ")"; }
+    static string extract(const string& term, int msb, int lsb) {
+        return "((_ extract " + cvtToStr(msb) + " " + cvtToStr(lsb) + ") " + term + ")";
+    }
+    static string resize(const string& term, int from, int to, bool isSigned) {
+        if (to == from) return term;
+        if (to < from) return extract(term, to - 1, 0);
+        return string{isSigned ? "((_ sign_extend " : "((_ zero_extend "} + cvtToStr(to - from)
+               + ") " + term + ")";
+    }
+    static string fromBool(const string& cond) { return "(ite " + cond + " #b1 #b0)"; }
+    static string toBool(const string& term, int width) {
+        return width == 1 ? "(= " + term + " #b1)" : "(distinct " + term + " " + zero(width) + ")";
+    }
+
+    static string smtName(const AstVarScope* vscp) {
+        // Top scope variables, which after inlining are all of them, have their C++ names
+        const string name = vscp->varp()->nameProtect();
+        return vscp->scopep()->isTop() ? name : vscp->scopep()->nameDotless() + "__DOT__" + name;
+    }
+
+    bool isBitVector(AstVarScope* vscp) {
+        const AstNodeDType* const dtypep = vscp->dtypep()->skipRefp();
+        if (dtypep->isCompound() || vscp->varp()->isString() || vscp->varp()->isDouble()) {
+            unsupported(vscp, "Variable " + vscp->varp()->prettyNameQ() + " is not a packed type");
+            return false;
+        }
+        return true;
+    }
+
+    // Term of the variable's value so far, declaring its current value if not yet assigned
+    string currentValue(AstVarScope* vscp) {
+        const auto it = m_values.find(vscp);
+        if (it != m_values.end()) return it->second;
+        if (!isBitVector(vscp)) return zero(1);
+        const string name = smtName(vscp);
+        m_values.emplace(vscp, name);
+        m_stateps.push_back(vscp);
+        return name;
+    }
+
+    // Evaluate the combinational blocks writing a variable, if not yet done
+    void evalWriters(AstVarScope* vscp) {
+        if (!m_combDemand) return;
+        const auto it = m_writers.find(vscp);
+        if (it == m_writers.end()) return;
+        for (const size_t idx : it->second) {
+            if (idx == m_combIdx || m_combStates[idx] == DONE) continue;
+            if (m_combStates[idx] == EVALUATING) {
+                unsupported(m_combBlocks[idx].m_nodep,
+                            "Combinational loop through " + vscp->varp()->prettyNameQ());
+                return;
+            }
+            evalComb(idx);
+        }
+    }
+
+    // Term of a variable read by an expression
+    string valueOf(AstVarScope* vscp) {
+        evalWriters(vscp);
+        return currentValue(vscp);
+    }
+
+    void assignValue(AstVarScope* vscp, const string& term) {
+        if (!isBitVector(vscp)) return;
+        const auto it = m_values.find(vscp);
+        m_undo.emplace_back(vscp, it == m_values.end() ? "" : it->second);
+        if (term.find('(') == string::npos) {  // Constant or another name, no need to define
+            m_values[vscp] = term;
+            return;
+        }
+        const string name = smtName(vscp) + "__Vsmt" + cvtToStr(++m_tmpNum);
+        m_defs << "(define-fun " << name << " () " << sort(vscp->width()) << " " << term << ")\n";
+        ++m_statDefs;
+        m_values[vscp] = name;
+    }
+
+    // Restore variables assigned since 'mark', returning the terms they had
+    void rollback(size_t mark, std::unordered_map<AstVarScope*, string>& valuesr,
+                  std::vector<AstVarScope*>& orderr) {
+        for (size_t i = mark; i < m_undo.size(); ++i) {
+            AstVarScope* const vscp = m_undo[i].first;
+            if (valuesr.emplace(vscp, m_values[vscp]).second) orderr.push_back(vscp);
+        }
+        for (size_t i = m_undo.size(); i-- > mark;) {
+            if (m_undo[i].second.empty()) {
+                m_values.erase(m_undo[i].first);
+            } else {
+                m_values[m_undo[i].first] = m_undo[i].second;
+            }
+        }
+        m_undo.resize(mark);
+    }
+
+    void evalStmts(AstNode* nodep) {
+        std::vector<std::pair<AstVarScope*, string>> undo;
+        // Assignments of a nested evaluation are not undone with the caller's branch
+        std::swap(undo, m_undo);
+        if (AstNodeProcedure* const procp = VN_CAST(nodep, NodeProcedure)) {
+            iterateAndNextNull(procp->stmtsp());
+        } else {
+            iterate(nodep);
+        }
+        std::swap(undo, m_undo);
+    }
+
+    void evalComb(size_t idx) {
+        m_combStates[idx] = EVALUATING;
+        const size_t lastIdx = m_combIdx;
+        m_combIdx = idx;
+        evalStmts(m_combBlocks[idx].m_nodep);
+        m_combIdx = lastIdx;
+        m_combStates[idx] = DONE;
+    }
+
+    string termOf(AstNode* nodep) {
+        iterate(nodep);
+        string term;
+        std::swap(term, m_term);
+        return term.empty() ? zero(std::max(nodep->width(), 1)) : term;
+    }
+    string operand(AstNode* nodep, int width, bool isSigned) {
+        return resize(termOf(nodep), nodep->width(), width, isSigned);
+    }
+    string boolOf(AstNode* nodep) { return toBool(termOf(nodep), nodep->width()); }
+
+    void binary(AstNodeBiop* nodep, const char* op) {
+        const bool isSigned = nodep->isSigned();
+        const string lhs = operand(nodep->lhsp(), nodep->width(), isSigned);
+        const string rhs = operand(nodep->rhsp(), nodep->width(), isSigned);
+        m_term = string{"("} + op + " " + lhs + " " + rhs + ")";
+    }
+    void division(AstNodeBiop* nodep, const char* op) {
+        // Division by zero gives zero, as in the C++ model
+        const bool isSigned = nodep->isSigned();
+        const string lhs = operand(nodep->lhsp(), nodep->width(), isSigned);
+        const string rhs = operand(nodep->rhsp(), nodep->width(), isSigned);
+        m_term = "(ite (= " + rhs + " " + zero(nodep->width()) + ") " + zero(nodep->width())
+                 + " (" + op + " " + lhs + " " + rhs + "))";
+    }
+    void compare(AstNodeBiop* nodep, const char* op, bool isSigned) {
+        const int width = std::max(nodep->lhsp()->width(), nodep->rhsp()->width());
+        const string lhs = operand(nodep->lhsp(), width, isSigned);
+        const string rhs = operand(nodep->rhsp(), width, isSigned);
+        m_term = fromBool(string{"("} + op + " " + lhs + " " + rhs + ")");
+    }
+    void shift(AstNodeBiop* nodep, const char* op, bool isSigned) {
+        // Shift in a width holding the amount, so large amounts shift everything out
+        const int width = std::max(nodep->width(), nodep->rhsp()->width());
+        const string lhs = operand(nodep->lhsp(), width, isSigned);
+        const string rhs = operand(nodep->rhsp(), width, false);
+        m_term = resize(string{"("} + op + " " + lhs + " " + rhs + ")", width, nodep->width(),
+                        false);
+    }
+    void logical(AstNodeBiop* nodep, const char* op) {
+        const string lhs = boolOf(nodep->lhsp());
+        const string rhs = boolOf(nodep->rhsp());
+        m_term = resize(fromBool(string{"("} + op + " " + lhs + " " + rhs + ")"), 1,
+                        nodep->width(), false);
+    }
+    string countOnes(AstNode* nodep, int width) {
+        const string term = termOf(nodep);
+        if (nodep->width() == 1) return resize(term, 1, width, false);
+        string sum = "(bvadd";
+        for (int bit = 0; bit < nodep->width(); ++bit) {
+            sum += " " + resize(extract(term, bit, bit), 1, width, false);
+        }
+        return sum + ")";
+    }
+    void reduction(AstNodeUniop* nodep, const char* op) {
+        const string term = termOf(nodep->lhsp());
+        string reduced = term;
+        if (nodep->lhsp()->width() > 1) {
+            reduced = string{"("} + op;
+            for (int bit = 0; bit < nodep->lhsp()->width(); ++bit) {
+                reduced += " " + extract(term, bit, bit);
+            }
+            reduced += ")";
+        }
+        m_term = resize(reduced, 1, nodep->width(), false);
+    }
+
+    // Assign 'value', of the given width, to an lvalue expression
+    void assignTo(AstNode* lhsp, const string& value, int width) {
+        if (AstVarRef* const refp = VN_CAST(lhsp, VarRef)) {
+            AstVarScope* const vscp = refp->varScopep();
+            assignValue(vscp, resize(value, width, vscp->width(), false));
+        } else if (AstSel* const selp = VN_CAST(lhsp, Sel)) {
+            AstVarRef* const refp = VN_CAST(selp->fromp(), VarRef);
+            if (!refp) {
+                unsupported(lhsp,
+                            "Assignment to a select of a " + selp->fromp()->prettyTypeName());
+                return;
+            }
+            AstVarScope* const vscp = refp->varScopep();
+            const int varWidth = vscp->width();
+            const int selWidth = selp->widthConst();
+            // The unassigned bits keep their value so far, without evaluating other writers
+            const string old = currentValue(vscp);
+            const string part = resize(value, width, selWidth, false);
+            if (VN_IS(selp->lsbp(), Const) && selp->msbConst() < varWidth) {
+                const int lsb = selp->lsbConst();
+                const int msb = selp->msbConst();
+                string term = part;
+                if (msb < varWidth - 1) {
+                    term = "(concat " + extract(old, varWidth - 1, msb + 1) + " " + term + ")";
+                }
+                if (lsb > 0) term = "(concat " + term + " " + extract(old, lsb - 1, 0) + ")";
+                assignValue(vscp, term);
+            } else {
+                // Bits shifted out of the variable are not written
+                const int shiftWidth = std::max(varWidth, selp->lsbp()->width());
+                const string lsb = operand(selp->lsbp(), shiftWidth, false);
+                const string mask = "(bvshl " + resize(ones(selWidth), selWidth, shiftWidth, false)
+                                    + " " + lsb + ")";
+                const string bits
+                    = "(bvshl " + resize(part, selWidth, shiftWidth, false) + " " + lsb + ")";
+                const string term = "(bvor (bvand " + resize(old, varWidth, shiftWidth, false)
+                                    + " (bvnot " + mask + ")) " + bits + ")";
+                assignValue(vscp, resize(term, shiftWidth, varWidth, false));
+            }
+        } else if (AstConcat* const concatp = VN_CAST(lhsp, Concat)) {
+            const int lowWidth = concatp->rhsp()->width();
+            const string full = resize(value, width, concatp->width(), false);
+            assignTo(concatp->lhsp(), extract(full, concatp->width() - 1, lowWidth),
+                     concatp->lhsp()->width());
+            assignTo(concatp->rhsp(), extract(full, lowWidth - 1, 0), lowWidth);
+        } else {
+            unsupported(lhsp, "Assignment to a " + lhsp->prettyTypeName());
+        }
+    }
+
+    // True if the clocked logic is triggered as the clocks rise
+    bool fires(AstActive* nodep) {
+        bool fired = false;
+        for (AstSenItem* itemp = nodep->sensesp()->sensesp(); itemp;
+             itemp = VN_AS(itemp->nextp(), SenItem)) {
+            const VEdgeType edge = itemp->edgeType();
+            const AstNodeVarRef* const refp = itemp->varrefp();
+            if (edge != VEdgeType::ET_POSEDGE && edge != VEdgeType::ET_NEGEDGE
+                && edge != VEdgeType::ET_BOTHEDGE && edge != VEdgeType::ET_CHANGED) {
+                unsupported(itemp, "Sensitivity to " + string{edge.ascii()});
+                return false;
+            }
+            // Complete lists were made combinational by V3Active, so this reads
+            // data, which the relation cannot both hold high and leave free
+            if (edge == VEdgeType::ET_CHANGED) {
+                unsupported(itemp, "Incomplete sensitivity list, sensitive to any change of "
+                                       + (refp ? refp->varp()->prettyNameQ()
+                                               : string{"an expression"}));
+                return false;
+            }
+            if (!refp) {
+                unsupported(itemp, "Sensitivity to an expression");
+                return false;
+            }
+            // Clocks driven by logic cannot be set high with the top level ones
+            if (valueOf(refp->varScopep()) != "#b1") {
+                unsupported(itemp, "Generated clock " + refp->varp()->prettyNameQ());
+                return false;
+            }
+            if (edge != VEdgeType::ET_NEGEDGE) fired = true;
+        }
+        return fired;
+    }
+
+    void transitionRelation() {
+        // Clocks rise from low to high, the other inputs are free
+        for (AstVarScope* const vscp : m_inputps) {
+            m_values.emplace(vscp, vscp->varp()->isUsedClock() ? "#b1" : smtName(vscp));
+        }
+        m_combStates.assign(m_combBlocks.size(), UNDONE);
+        for (size_t idx = 0; idx < m_combBlocks.size(); ++idx) {
+            for (AstVarScope* const vscp : m_combBlocks[idx].m_writeps) {
+                m_writers[vscp].push_back(idx);
+            }
+        }
+
+        // Before the edge
+        m_combDemand = true;
+        std::vector<AstNode*> preps;
+        std::vector<AstNode*> alwaysps;
+        std::vector<AstNode*> postps;
+        for (AstActive* const activep : m_clockedps) {
+            if (!fires(activep)) continue;
+            for (AstNode* stmtp = activep->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+                if (VN_IS(stmtp, AlwaysPublic)) continue;
+                const EmitSmtBlock block{stmtp};
+                for (AstVarScope* const vscp : block.m_refps) evalWriters(vscp);
+                for (AstVarScope* const vscp : block.m_writeps) {
+                    if (m_writers.count(vscp)) {
+                        unsupported(stmtp, "Variable " + vscp->varp()->prettyNameQ()
+                                               + " written by clocked and combinational logic");
+                    }
+                    // Registers are state, even if their current value is never read
+                    if (!vscp->varp()->isTemp()) currentValue(vscp);
+                }
+                if (VN_IS(stmtp, AssignPre)) {
+                    preps.push_back(stmtp);
+                } else if (VN_IS(stmtp, AssignPost) || VN_IS(stmtp, AlwaysPost)) {
+                    postps.push_back(stmtp);
+                } else {
+                    alwaysps.push_back(stmtp);
+                }
+            }
+            if (m_failed) return;
+        }
+
+        // The edge, non-blocking assignments are committed by the post blocks
+        m_combDemand = false;
+        for (const std::vector<AstNode*>* const stmtsp : {&preps, &alwaysps, &postps}) {
+            for (AstNode* const stmtp : *stmtsp) evalStmts(stmtp);
+        }
+
+        // After the edge
+        m_combDemand = true;
+        m_combStates.assign(m_combBlocks.size(), UNDONE);
+        for (AstVarScope* const vscp : m_outputps) valueOf(vscp);
+    }
+
+    void write(const string& filename) {
+        const std::unique_ptr<std::ofstream> ofp{V3File::new_ofstream(filename)};
+        if (ofp->fail()) v3fatal("Can't write " << filename);
+        std::ofstream& os = *ofp;
+        os << "; Verilated -*- SMT-LIB -*-\n";
+        os << "; DESCRIPTION: Transition relation of one rising clock edge, created with "
+              "Verilator --smt2\n";
+        os << "\n(set-logic QF_BV)\n";
+        os << "\n; Inputs\n";
+        for (AstVarScope* const vscp : m_inputps) {
+            if (vscp->varp()->isUsedClock()) continue;
+            os << "(declare-fun " << smtName(vscp) << " () " << sort(vscp->width()) << ")\n";
+        }
+        os << "\n; Current state\n";
+        for (AstVarScope* const vscp : m_stateps) {
+            os << "(declare-fun " << smtName(vscp) << " () " << sort(vscp->width()) << ")\n";
+        }
+        os << "\n; Logic\n";
+        os << m_defs.str();
+        os << "\n; Next state\n";
+        for (AstVarScope* const vscp : m_stateps) {
+            if (vscp->varp()->isPrimaryIO() && vscp->scopep()->isTop()) continue;
+            os << "(define-fun " << smtName(vscp) << "__next () " << sort(vscp->width()) << " "
+               << m_values.at(vscp) << ")\n";
+        }
+        os << "\n; Outputs after the edge\n";
+        for (AstVarScope* const vscp : m_outputps) {
+            os << "(define-fun " << smtName(vscp) << "__next () " << sort(vscp->width()) << " "
+               << m_values.at(vscp) << ")\n";
+        }
+    }
+
+    // VISITORS - Logic collection
+    void visit(AstNetlist* nodep) override {
+        nodep->foreach([this](AstVarScope* vscp) {
+            const AstVar* const varp = vscp->varp();
+            if (!varp->isPrimaryIO() || !vscp->scopep()->isTop()) return;
+            if (varp->isInoutish()) {
+                unsupported(vscp, "Inout port " + varp->prettyNameQ());
+            } else if (isBitVector(vscp)) {
+                (varp->isNonOutput() ? m_inputps : m_outputps).push_back(vscp);
+            }
+        });
+        nodep->foreach([this](AstActive* activep) {
+            const AstSenTree* const sensesp = activep->sensesp();
+            // Initial values are overwritten by the current state, as with --sym-exec-main
+            if (sensesp->hasStatic() || sensesp->hasInitial() || sensesp->hasFinal()) return;
+            if (sensesp->hasCombo()) {
+                for (AstNode* stmtp = activep->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+                    if (!VN_IS(stmtp, AlwaysPublic)) m_combBlocks.emplace_back(stmtp);
+                }
+            } else if (sensesp->hasClocked()) {
+                m_clockedps.push_back(activep);
+            } else {
+                unsupported(activep, "Logic sensitive to " + activep->prettyTypeName());
+            }
+        });
+        if (m_failed) return;
+        transitionRelation();
+        if (m_failed) return;
+        write(v3Global.opt.makeDir() + "/" + v3Global.opt.prefix() + ".smt2");
+        V3Stats::addStat("SMT, Definitions", m_statDefs);
+        V3Stats::addStat("SMT, State variables", m_stateps.size());
+    }
+
+    // VISITORS - Statements
+    void visit(AstNodeProcedure* nodep) override { iterateAndNextNull(nodep->stmtsp()); }
+    void visit(AstNodeAssign* nodep) override {
+        if (m_failed) return;
+        if (VN_IS(nodep, AssignDly) || VN_IS(nodep, AssignForce)) {
+            unsupported(nodep, nodep->prettyTypeName());
+            return;
+        }
+        const string value = termOf(nodep->rhsp());
+        assignTo(nodep->lhsp(), value, nodep->rhsp()->width());
+    }
+    void visit(AstNodeIf* nodep) override {
+        if (m_failed) return;
+        const string cond = "__Vsmt" + cvtToStr(++m_tmpNum);
+        m_defs << "(define-fun " << cond << " () Bool " << boolOf(nodep->condp()) << ")\n";
+        ++m_statDefs;
+        const size_t mark = m_undo.size();
+        std::unordered_map<AstVarScope*, string> thenValues;
+        std::unordered_map<AstVarScope*, string> elseValues;
+        std::vector<AstVarScope*> order;
+        iterateAndNextNull(nodep->thensp());
+        rollback(mark, thenValues, order);
+        iterateAndNextNull(nodep->elsesp());
+        rollback(mark, elseValues, order);
+        for (AstVarScope* const vscp : order) {
+            const auto thenIt = thenValues.find(vscp);
+            const auto elseIt = elseValues.find(vscp);
+            const string thenTerm
+                = thenIt != thenValues.end() ? thenIt->second : currentValue(vscp);
+            const string elseTerm
+                = elseIt != elseValues.end() ? elseIt->second : currentValue(vscp);
+            assignValue(vscp, thenTerm == elseTerm
+                                  ? thenTerm
+                                  : "(ite " + cond + " " + thenTerm + " " + elseTerm + ")");
+        }
+    }
+    void visit(AstComment*) override {}
+    void visit(AstDisplay*) override {}  // No effect on the state
+
+    // VISITORS - Expressions
+    void visit(AstConst* nodep) override {
+        if (nodep->num().isDouble() || nodep->num().isString()) {
+            unsupported(nodep, "Non-packed constant");
+            return;
+        }
+        // Two state, as in the C++ model X and Z bits are zero
+        const V3Number& num = nodep->num();
+        string bits;
+        if (nodep->width() % 4 == 0) {
+            static const char* const digits = "0123456789abcdef";
+            bits = "#x";
+            for (int lsb = nodep->width() - 4; lsb >= 0; lsb -= 4) {
+                const int digit = (num.bitIs1(lsb + 3) << 3) | (num.bitIs1(lsb + 2) << 2)
+                                  | (num.bitIs1(lsb + 1) << 1) | num.bitIs1(lsb);
+                bits += digits[digit];
+            }
+        } else {
+            bits = "#b";
+            for (int bit = nodep->width() - 1; bit >= 0; --bit) {
+                bits += num.bitIs1(bit) ? '1' : '0';
+            }
+        }
+        m_term = bits;
+    }
+    void visit(AstVarRef* nodep) override { m_term = valueOf(nodep->varScopep()); }
+    void visit(AstSel* nodep) override {
+        const int fromWidth = nodep->fromp()->width();
+        const int width = nodep->widthConst();
+        if (VN_IS(nodep->lsbp(), Const)) {
+            const int lsb = nodep->lsbConst();
+            const int msb = lsb + width - 1;
+            // Bits above the expression read as zero
+            m_term = extract(operand(nodep->fromp(), std::max(fromWidth, msb + 1), false), msb,
+                             lsb);
+        } else {
+            const int shiftWidth = std::max({fromWidth, nodep->lsbp()->width(), width});
+            const string from = operand(nodep->fromp(), shiftWidth, false);
+            const string lsb = operand(nodep->lsbp(), shiftWidth, false);
+            m_term = extract("(bvlshr " + from + " " + lsb + ")", width - 1, 0);
+        }
+    }
+    void visit(AstConcat* nodep) override {
+        const string lhs = termOf(nodep->lhsp());
+        const string rhs = termOf(nodep->rhsp());
+        m_term = "(concat " + lhs + " " + rhs + ")";
+    }
+    void visit(AstReplicate* nodep) override {
+        const AstConst* const countp = VN_CAST(nodep->countp(), Const);
+        if (!countp || countp->toUInt() == 0) {
+            unsupported(nodep, "Replication count that is not a positive constant");
+            return;
+        }
+        const string src = termOf(nodep->srcp());
+        string term = src;
+        for (uint32_t i = 1; i < countp->toUInt(); ++i) term = "(concat " + src + " " + term + ")";
+        m_term = term;
+    }
+    void visit(AstNodeCond* nodep) override {
+        const string cond = boolOf(nodep->condp());
+        const string thenTerm = operand(nodep->thenp(), nodep->width(), nodep->isSigned());
+        const string elseTerm = operand(nodep->elsep(), nodep->width(), nodep->isSigned());
+        m_term = "(ite " + cond + " " + thenTerm + " " + elseTerm + ")";
+    }
+    void visit(AstExtend* nodep) override {
+        m_term = operand(nodep->lhsp(), nodep->width(), false);
+    }
+    void visit(AstExtendS* nodep) override {
+        m_term = operand(nodep->lhsp(), nodep->width(), true);
+    }
+    void visit(AstNot* nodep) override {
+        m_term = "(bvnot " + operand(nodep->lhsp(), nodep->width(), nodep->isSigned()) + ")";
+    }
+    void visit(AstNegate* nodep) override {
+        m_term = "(bvneg " + operand(nodep->lhsp(), nodep->width(), nodep->isSigned()) + ")";
+    }
+    void visit(AstLogNot* nodep) override {
+        m_term = resize(fromBool("(not " + boolOf(nodep->lhsp()) + ")"), 1, nodep->width(),
+                        false);
+    }
+    void visit(AstRedAnd* nodep) override { reduction(nodep, "bvand"); }
+    void visit(AstRedOr* nodep) override { reduction(nodep, "bvor"); }
+    void visit(AstRedXor* nodep) override { reduction(nodep, "bvxor"); }
+    void visit(AstCountOnes* nodep) override { m_term = countOnes(nodep->lhsp(), nodep->width()); }
+    void visit(AstOneHot* nodep) override {
+        const int width = std::max(nodep->lhsp()->width(), 2);
+        m_term = resize(fromBool("(= " + countOnes(nodep->lhsp(), width) + " "
+                                 + resize("#b1", 1, width, false) + ")"),
+                        1, nodep->width(), false);
+    }
+    void visit(AstOneHot0* nodep) override {
+        const int width = std::max(nodep->lhsp()->width(), 2);
+        m_term = resize(fromBool("(bvule " + countOnes(nodep->lhsp(), width) + " "
+                                 + resize("#b1", 1, width, false) + ")"),
+                        1, nodep->width(), false);
+    }
+    void visit(AstAnd* nodep) override { binary(nodep, "bvand"); }
+    void visit(AstOr* nodep) override { binary(nodep, "bvor"); }
+    void visit(AstXor* nodep) override { binary(nodep, "bvxor"); }
+    void visit(AstAdd* nodep) override { binary(nodep, "bvadd"); }
+    void visit(AstSub* nodep) override { binary(nodep, "bvsub"); }
+    void visit(AstMul* nodep) override { binary(nodep, "bvmul"); }
+    void visit(AstMulS* nodep) override { binary(nodep, "bvmul"); }
+    void visit(AstDiv* nodep) override { division(nodep, "bvudiv"); }
+    void visit(AstDivS* nodep) override { division(nodep, "bvsdiv"); }
+    void visit(AstModDiv* nodep) override { division(nodep, "bvurem"); }
+    void visit(AstModDivS* nodep) override { division(nodep, "bvsrem"); }
+    void visit(AstShiftL* nodep) override { shift(nodep, "bvshl", false); }
+    void visit(AstShiftR* nodep) override { shift(nodep, "bvlshr", false); }
+    void visit(AstShiftRS* nodep) override { shift(nodep, "bvashr", true); }
+    void visit(AstEq* nodep) override { compare(nodep, "=", false); }
+    void visit(AstEqCase* nodep) override { compare(nodep, "=", false); }
+    void visit(AstNeq* nodep) override { compare(nodep, "distinct", false); }
+    void visit(AstNeqCase* nodep) override { compare(nodep, "distinct", false); }
+    void visit(AstLt* nodep) override { compare(nodep, "bvult", false); }
+    void visit(AstLtS* nodep) override { compare(nodep, "bvslt", true); }
+    void visit(AstLte* nodep) override { compare(nodep, "bvule", false); }
+    void visit(AstLteS* nodep) override { compare(nodep, "bvsle", true); }
+    void visit(AstGt* nodep) override { compare(nodep, "bvugt", false); }
+    void visit(AstGtS* nodep) override { compare(nodep, "bvsgt", true); }
+    void visit(AstGte* nodep) override { compare(nodep, "bvuge", false); }
+    void visit(AstGteS* nodep) override { compare(nodep, "bvsge", true); }
+    void visit(AstLogAnd* nodep) override { logical(nodep, "and"); }
+    void visit(AstLogOr* nodep) override { logical(nodep, "or"); }
+    void visit(AstLogEq* nodep) override { logical(nodep, "="); }
+    void visit(AstLogIf* nodep) override { logical(nodep, "=>"); }
+
+    //--------------------
+    void visit(AstNode* nodep) override {
+        unsupported(nodep, "Cannot translate " + nodep->prettyTypeName());
+    }
+
+public:
+    // CONSTRUCTORS
+    explicit EmitSmtVisitor(AstNetlist* nodep) { iterate(nodep); }
+    ~EmitSmtVisitor() override = default;
+};
+
+//######################################################################
+// EmitSmt class functions
+
+void V3EmitSmt::emit(AstNetlist* nodep) {
+    UINFO(2, __FUNCTION__ << ": " << endl);
+    { EmitSmtVisitor{nodep}; }
+}
@@ -805,8 +805,8 @@ class EmitVPrefixedFormatter final : public V3OutFormatter {
         }
     }
 
-    void putsOutput(const char* strg) override {
-        for (const char* cp = strg; *cp; cp++) putcOutput(*cp);
+    void putsOutput(const char* strg, size_t len) override {
+        for (const char* cp = strg; cp != strg + len; ++cp) putcOutput(*cp);
     }
 
 public:
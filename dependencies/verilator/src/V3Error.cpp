@@ -43,6 +43,8 @@ bool V3Error::s_describedWarnings = false;
 bool V3Error::s_describedWeb = false;
 V3Error::MessagesSet V3Error::s_messages;
 V3Error::ErrorExitCb V3Error::s_errorExitCb = nullptr;
+bool V3Error::s_abortOnFatalSrc = false;
+V3Error::ErrorExitCb V3Error::s_exitCb = nullptr;
 
 struct v3errorIniter {
     v3errorIniter() { V3Error::init(); }
@@ -77,6 +79,24 @@ void V3Error::init() {
     }
 }
 
+void V3Error::reset() {
+    s_errCount = 0;
+    s_warnCount = 0;
+    s_debugDefault = 0;
+    s_errorLimit = V3Error::MAX_ERRORS;
+    s_warnFatal = true;
+    s_tellManual = 0;
+    s_errorStr.str("");
+    s_errorCode = V3ErrorCode::EC_FATAL;
+    s_errorContexted = false;
+    s_errorSuppressed = false;
+    s_describedWarnings = false;
+    s_describedWeb = false;
+    s_messages.clear();
+    s_errorExitCb = nullptr;
+    init();
+}
+
 string V3Error::lineStr(const char* filename, int lineno) {
     std::ostringstream out;
     const char* const fnslashp = std::strrchr(filename, '/');
@@ -163,6 +183,7 @@ void V3Error::vlAbortOrExit() {
         std::cerr << msgPrefix() << "Aborting since under --debug" << endl;
         V3Error::vlAbort();
     } else {
+        if (s_exitCb) s_exitCb();
         std::exit(1);
     }
 }
@@ -287,6 +308,7 @@ void V3Error::v3errorEnd(std::ostringstream& sstr, const string& extra) {
 #endif
             }
 
+            if (s_abortOnFatalSrc && s_errorCode == V3ErrorCode::EC_FATALSRC) vlAbort();
             vlAbortOrExit();
         } else if (anError) {
             // We don't dump tree on any error because a Visitor may be in middle of
@@ -273,6 +273,8 @@ private:
     static bool s_errorSuppressed;  // Error being formed should be suppressed
     static MessagesSet s_messages;  // What errors we've outputted
     static ErrorExitCb s_errorExitCb;  // Callback when error occurs for dumping
+    static bool s_abortOnFatalSrc;  // Abort on internal errors, so fuzzers see them as crashes
+    static ErrorExitCb s_exitCb;  // Callback instead of exiting, to Verilate again in-process
 
     static constexpr unsigned MAX_ERRORS = 50;  // Fatal after this may errors
 
@@ -289,6 +291,9 @@ public:
     static void errorLimit(int level) { s_errorLimit = level; }
     static int errorLimit() VL_MT_SAFE { return s_errorLimit; }
     static void warnFatal(bool flag) { s_warnFatal = flag; }
+    static void abortOnFatalSrc(bool flag) { s_abortOnFatalSrc = flag; }
+    // Call instead of exit(1) on errors; must not return, e.g. throw to an outer loop
+    static void exitCb(ErrorExitCb cb) { s_exitCb = cb; }
     static bool warnFatal() { return s_warnFatal; }
     static string msgPrefix();  // returns %Error/%Warn
     static int errorCount() VL_MT_SAFE { return s_errCount; }
@@ -299,6 +304,7 @@ public:
     static void incErrors();
     static void incWarnings() { s_warnCount++; }
     static void init();
+    static void reset();  // Forget messages and counts, to Verilate again in-process
     static void abortIfErrors() {
         if (errorCount()) abortIfWarnings();
     }
@@ -0,0 +1,392 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Evaluate combinational designs on input patterns
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2003-2022 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+// V3EvalPatterns's Transformations:
+//
+// For --eval-patterns, instead of emitting C++:
+//      Collect the static, initial and combinational logic blocks
+//      Order the combinational blocks so each follows the blocks
+//          writing variables it reads
+//      Evaluate the static and initial blocks once
+//      For each pattern in the file
+//          Set the top level inputs from the pattern
+//          Evaluate each combinational block with SimulateVisitor,
+//              repeating until no value changes if the logic has a loop
+//          Print the inputs and outputs as vlog-hammer's testbenches do,
+//              reporting output <name>_y as <name> and masking undefined bits
+//
+//*************************************************************************
+
+#include "config_build.h"
+#include "verilatedos.h"
+
+#include "V3EvalPatterns.h"
+
+#include "V3Ast.h"
+#include "V3File.h"
+#include "V3Global.h"
+#include "V3Os.h"
+#include "V3Simulate.h"
+#include "V3String.h"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+VL_DEFINE_DEBUG_FUNCTIONS;
+
+//######################################################################
+// A logic block, and the variables it reads and writes
+
+class EvalPatternsBlock final {
+public:
+    AstNode* const m_nodep;  // AstAlways, AstAssignW etc.
+    std::vector<AstVarScope*> m_readps;  // Variables read, including those partly written
+    std::vector<AstVarScope*> m_writeps;  // Variables written
+    explicit EvalPatternsBlock(AstNode* nodep)
+        : m_nodep{nodep} {}
+};
+
+//######################################################################
+// Find variables referenced by a block
+
+class EvalPatternsRefVisitor final : public VNVisitor {
+    // STATE
+    EvalPatternsBlock& m_block;  // Block being collected
+    std::unordered_set<AstVarScope*> m_reads;  // Variables in m_block.m_readps
+    std::unordered_set<AstVarScope*> m_writes;  // Variables in m_block.m_writeps
+
+    // VISITORS
+    void visit(AstVarRef* nodep) override {
+        AstVarScope* const vscp = nodep->varScopep();
+        UASSERT_OBJ(vscp, nodep, "Not linked");
+        // Partial writes merge into the previous value, so read all written variables too
+        if (m_reads.insert(vscp).second) m_block.m_readps.push_back(vscp);
+        if (nodep->access().isWriteOrRW() && m_writes.insert(vscp).second) {
+            m_block.m_writeps.push_back(vscp);
+        }
+    }
+    void visit(AstNode* nodep) override { iterateChildren(nodep); }
+
+public:
+    // CONSTRUCTORS
+    explicit EvalPatternsRefVisitor(EvalPatternsBlock& block)
+        : m_block{block} {
+        iterate(block.m_nodep);
+    }
+    ~EvalPatternsRefVisitor() override = default;
+};
+
+//######################################################################
+// Evaluate the design
+
+class EvalPatternsVisitor final : public VNVisitor {
+    // STATE
+    std::vector<EvalPatternsBlock> m_initBlocks;  // Static and initial logic, in order
+    std::vector<EvalPatternsBlock> m_combBlocks;  // Combinational logic, ordered by dependency
+    std::unordered_map<AstVarScope*, AstNode*> m_values;  // Current value of each variable
+    std::vector<AstConst*> m_ownedps;  // Values in m_values to delete
+    std::vector<AstVarScope*> m_inputps;  // Top level inputs, in declaration order
+    std::vector<AstVarScope*> m_outputps;  // Top level outputs, in declaration order
+    bool m_combLoop = false;  // Combinational blocks depend on each other in a loop
+    bool m_failed = false;  // Reported an error, stop evaluating
+
+    // METHODS
+    void unsupported(AstNode* nodep, const string& why) {
+        if (m_failed) return;
+        m_failed = true;
+        nodep->v3warn(E_UNSUPPORTED, "Unsupported: --eval-patterns: " << why);
+    }
+
+    static bool isSimpleValue(const AstVarScope* vscp) {
+        const AstNodeDType* const dtypep = vscp->dtypep()->skipRefp();
+        return !dtypep->isCompound() || dtypep->isString();
+    }
+
+    void initValue(AstVarScope* vscp) {
+        // SimulateVisitor takes parameter values from the tree itself
+        if (vscp->varp()->isParam() || m_values.count(vscp)) return;
+        AstConst* const constp
+            = new AstConst{vscp->fileline(), AstConst::DTyped{}, vscp->dtypep()};
+        m_ownedps.push_back(constp);
+        m_values.emplace(vscp, constp);
+    }
+
+    void addBlock(std::vector<EvalPatternsBlock>& blocks, AstNode* nodep) {
+        blocks.emplace_back(nodep);
+        EvalPatternsBlock& block = blocks.back();
+        { EvalPatternsRefVisitor{block}; }
+        for (AstVarScope* const vscp : block.m_readps) {
+            if (vscp->varp()->isParam()) continue;
+            if (!isSimpleValue(vscp)) {
+                unsupported(nodep, "Unpacked or class variable " + vscp->varp()->prettyNameQ());
+                return;
+            }
+            initValue(vscp);
+        }
+    }
+
+    void orderCombBlocks() {
+        // Depth first, so each block comes after the blocks writing what it reads
+        std::unordered_map<AstVarScope*, std::vector<size_t>> writers;
+        for (size_t i = 0; i < m_combBlocks.size(); ++i) {
+            for (AstVarScope* const vscp : m_combBlocks[i].m_writeps) writers[vscp].push_back(i);
+        }
+        std::vector<std::vector<size_t>> deps(m_combBlocks.size());
+        for (size_t i = 0; i < m_combBlocks.size(); ++i) {
+            for (AstVarScope* const vscp : m_combBlocks[i].m_readps) {
+                const auto it = writers.find(vscp);
+                if (it == writers.end()) continue;
+                for (const size_t dep : it->second) {
+                    if (dep != i) deps[i].push_back(dep);  // Not its own partial writes
+                }
+            }
+        }
+        enum : uint8_t { UNVISITED, VISITING, DONE };
+        std::vector<uint8_t> state(m_combBlocks.size(), UNVISITED);
+        std::vector<size_t> order;
+        // Explicit stack of (block, next dependency index), as netlists may be deep
+        std::vector<std::pair<size_t, size_t>> stack;
+        for (size_t root = 0; root < m_combBlocks.size(); ++root) {
+            if (state[root] != UNVISITED) continue;
+            stack.emplace_back(root, 0);
+            state[root] = VISITING;
+            while (!stack.empty()) {
+                const size_t blk = stack.back().first;
+                if (stack.back().second == deps[blk].size()) {
+                    state[blk] = DONE;
+                    order.push_back(blk);
+                    stack.pop_back();
+                    continue;
+                }
+                const size_t dep = deps[blk][stack.back().second++];
+                if (state[dep] == VISITING) {
+                    m_combLoop = true;
+                } else if (state[dep] == UNVISITED) {
+                    state[dep] = VISITING;
+                    stack.emplace_back(dep, 0);
+                }
+            }
+        }
+        std::vector<EvalPatternsBlock> ordered;
+        ordered.reserve(order.size());
+        for (const size_t i : order) ordered.push_back(std::move(m_combBlocks[i]));
+        m_combBlocks = std::move(ordered);
+    }
+
+    // Evaluate a block, return true if any variable changed
+    bool evalBlock(SimulateVisitor& simvis, const EvalPatternsBlock& block) {
+        simvis.clear();
+        for (AstVarScope* const vscp : block.m_readps) {
+            const auto it = m_values.find(vscp);
+            if (it != m_values.end()) simvis.newValue(vscp, it->second);
+        }
+        simvis.mainEvalEmulate(block.m_nodep);
+        if (!simvis.optimizable()) {
+            unsupported(simvis.whyNotNodep() ? simvis.whyNotNodep() : block.m_nodep,
+                        "Cannot evaluate: " + simvis.whyNotMessage());
+            return false;
+        }
+        bool changed = false;
+        for (AstVarScope* const vscp : block.m_writeps) {
+            V3Number* const outnump = simvis.fetchOutNumberNull(vscp);
+            if (!outnump) continue;  // Not assigned on this path, keeps its value
+            AstConst* const constp = VN_AS(m_values.at(vscp), Const);
+            if (!constp->num().isCaseEq(*outnump)) {
+                constp->num().opAssign(*outnump);
+                changed = true;
+            }
+        }
+        return changed;
+    }
+
+    void evalComb(SimulateVisitor& simvis) {
+        // Ordered acyclic logic settles in one pass, loops need more
+        const size_t maxPasses = m_combLoop ? m_combBlocks.size() + 1 : 1;
+        for (size_t pass = 0; pass < maxPasses; ++pass) {
+            bool changed = false;
+            for (const EvalPatternsBlock& block : m_combBlocks) {
+                changed |= evalBlock(simvis, block);
+                if (m_failed) return;
+            }
+            if (!changed) return;
+        }
+        if (m_combLoop) {
+            unsupported(m_combBlocks.front().m_nodep,
+                        "Combinational loop did not settle after " + cvtToStr(maxPasses)
+                            + " passes");
+        }
+    }
+
+    static string bits(AstNode* valuep) {
+        return VN_AS(valuep, Const)->num().displayed(valuep, "%b");
+    }
+
+    // vlog-hammer's testbench has an output <name>_y per synthesis result, reported as <name>
+    static string reportName(const string& name) {
+        if (name.size() > 2 && VString::endsWith(name, "_y")) {
+            return name.substr(0, name.size() - 2);
+        }
+        return name;
+    }
+
+    // As verilator_tb.h's set_undef, bits that are 'x' in the reference are reported as 'x'
+    static void maskUndef(string& value, const string& undef) {
+        for (size_t bit = 0; bit < undef.size() && bit < value.size(); ++bit) {
+            const char ch = undef[undef.size() - 1 - bit];
+            if (ch == 'x' || ch == 'X') value[value.size() - 1 - bit] = 'x';
+        }
+    }
+
+    void evalPatterns(const string& filename) {
+        const std::unique_ptr<std::ifstream> ifp{V3File::new_ifstream(filename)};
+        if (ifp->fail()) {
+            v3error("Cannot open --eval-patterns file: " << filename);
+            return;
+        }
+        int inputWidth = 0;
+        for (const AstVarScope* const vscp : m_inputps) inputWidth += vscp->width();
+
+        SimulateVisitor simvis;
+        for (const EvalPatternsBlock& block : m_initBlocks) {
+            evalBlock(simvis, block);
+            if (m_failed) return;
+        }
+
+        FileLine* const fl = new FileLine{filename};
+        int index = 0;
+        int lineno = 0;
+        while (!ifp->eof()) {
+            string line = V3Os::getline(*ifp);
+            fl->lineno(++lineno);
+            // Same syntax as vlog-hammer patterns: [~]<width>'b<bits> or [~]<width>'h<hex>,
+            // optionally followed by the reference output with 'x' for its undefined bits
+            const string::size_type cmt = line.find("//");
+            if (cmt != string::npos) line.erase(cmt);
+            std::istringstream tokens{line};
+            string undef;
+            line.clear();
+            tokens >> line >> undef;
+            if (line.empty()) continue;
+            string extra;
+            if (tokens >> extra) {
+                fl->v3error("--eval-patterns line has text after the undefined bits: " << extra);
+                continue;
+            }
+            const bool invert = line[0] == '~';
+            if (invert) line.erase(0, 1);
+            if (line.find('\'') == string::npos) {
+                fl->v3error("--eval-patterns pattern needs a base, e.g. 'b or 'h: " << line);
+                continue;
+            }
+            const V3Number parsed{fl, line.c_str()};
+            // Zero extend, or with '~' one extend, to the total input width
+            V3Number pattern{fl, std::max(inputWidth, 1), 0};
+            pattern.opSelInto(parsed, 0, std::min(parsed.width(), pattern.width()));
+            if (invert) {
+                V3Number inverted{fl, pattern.width(), 0};
+                inverted.opNot(pattern);
+                pattern = inverted;
+            }
+
+            // The last input takes the least significant bits, as {in1, in2, ...} = pattern
+            int lsb = 0;
+            for (auto it = m_inputps.rbegin(); it != m_inputps.rend(); ++it) {
+                AstConst* const constp = VN_AS(m_values[*it], Const);
+                constp->num().opSel(pattern, lsb + (*it)->width() - 1, lsb);
+                lsb += (*it)->width();
+            }
+            evalComb(simvis);
+            if (m_failed) return;
+
+            std::ostream& os = std::cout;
+            string inputBits;
+            for (AstVarScope* const vscp : m_inputps) {
+                const string value = bits(m_values[vscp]);
+                os << "++PAT++ " << index << " " << vscp->varp()->prettyName() << " " << value
+                   << " #\n";
+                inputBits += (inputBits.empty() ? "" : " ") + value;
+            }
+            for (AstVarScope* const vscp : m_outputps) {
+                string value = bits(m_values[vscp]);
+                maskUndef(value, undef);
+                const string name = reportName(vscp->varp()->prettyName());
+                os << "++VAL++ " << index << " " << name << " " << value << " #\n";
+                os << "++RPT++ " << index << " " << inputBits << " " << value << " " << name
+                   << "\n";
+            }
+            os << "++RPT++ ----\n";
+            ++index;
+        }
+        std::cout << "++OK++" << std::endl;
+    }
+
+    // VISITORS
+    void visit(AstActive* nodep) override {
+        const AstSenTree* const sensesp = nodep->sensesp();
+        const bool comb = sensesp->hasCombo();
+        const bool init = sensesp->hasStatic() || sensesp->hasInitial();
+        if (sensesp->hasFinal()) return;
+        if (!comb && !init) {
+            unsupported(nodep->stmtsp() ? nodep->stmtsp() : nodep,
+                        "Only combinational logic can be evaluated, not clocked logic");
+            return;
+        }
+        for (AstNode* stmtp = nodep->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+            if (VN_IS(stmtp, AlwaysPublic)) continue;
+            addBlock(comb ? m_combBlocks : m_initBlocks, stmtp);
+        }
+    }
+    void visit(AstVarScope* nodep) override {
+        const AstVar* const varp = nodep->varp();
+        if (!varp->isPrimaryIO() || !nodep->scopep()->isTop()) return;
+        if (varp->isInoutish()) {
+            unsupported(nodep, "Inout port " + varp->prettyNameQ());
+        } else if (!isSimpleValue(nodep) || varp->isString() || varp->isDouble()) {
+            unsupported(nodep, "Port " + varp->prettyNameQ() + " is not a packed type");
+        } else if (varp->isNonOutput()) {
+            m_inputps.push_back(nodep);
+        } else {
+            m_outputps.push_back(nodep);
+        }
+        initValue(nodep);
+    }
+    void visit(AstNodeMath*) override {}  // Accelerate
+    void visit(AstNode* nodep) override { iterateChildren(nodep); }
+
+public:
+    // CONSTRUCTORS
+    explicit EvalPatternsVisitor(AstNetlist* nodep) {
+        iterate(nodep);
+        if (m_failed) return;
+        orderCombBlocks();
+        evalPatterns(v3Global.opt.evalPatterns());
+    }
+    ~EvalPatternsVisitor() override {
+        for (AstConst* const constp : m_ownedps) VL_DO_DANGLING(constp->deleteTree(), constp);
+    }
+};
+
+//######################################################################
+// EvalPatterns class functions
+
+void V3EvalPatterns::evalPatternsAll(AstNetlist* nodep) {
+    UINFO(2, __FUNCTION__ << ": " << endl);
+    { EvalPatternsVisitor{nodep}; }
+}
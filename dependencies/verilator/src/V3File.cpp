@@ -22,6 +22,7 @@
 #include "V3Ast.h"
 #include "V3Global.h"
 #include "V3Os.h"
+#include "V3Stats.h"
 #include "V3String.h"
 
 #include <cerrno>
@@ -48,6 +49,8 @@
 #endif
 
 #ifdef INFILTER_PIPE
+# define INFILTER_MMAP  // Map large unfiltered files rather than reading them
+# include <sys/mman.h>
 # include <sys/wait.h>
 #endif
 
@@ -320,20 +323,111 @@ void V3File::createMakeDirFor(const string& filename) {
     }
 }
 void V3File::createMakeDir() {
-    static bool created = false;
-    if (!created) {
-        created = true;
+    // Track by name, as a --fork-config backend or --hierarchical-fork run
+    // moves these after startup
+    static string s_created;
+    if (s_created != v3Global.opt.hierTopDataDir()) {
+        s_created = v3Global.opt.hierTopDataDir();
         V3Os::createDir(v3Global.opt.makeDir());
         if (v3Global.opt.hierTop()) V3Os::createDir(v3Global.opt.hierTopDataDir());
     }
 }
 
+//######################################################################
+// VOutArchive
+
+class VOutArchiveImp final {
+    // Generated files held for --output-archive, by name for a stable order
+    std::map<const std::string, std::string> m_files;
+
+    static void putOctal(char* fieldp, size_t width, uint64_t value) {
+        // Zero padded, with the terminating NUL taking the last character
+        VL_SNPRINTF(fieldp, width, "%0*" PRIo64, static_cast<int>(width - 1), value);
+    }
+    static void putHeader(string& out, const string& name, char typeflag, size_t size) {
+        // POSIX ustar header block
+        char header[512] = {};
+        string prefix;
+        string base = name;
+        if (base.size() > 100) {
+            // Split at a '/' into the 155 byte prefix and 100 byte name fields
+            const size_t slash = base.find('/', base.size() - 101);
+            if (slash != string::npos && slash > 0 && slash <= 155) {
+                prefix = base.substr(0, slash);
+                base = base.substr(slash + 1);
+            }
+        }
+        if (base.size() > 100) {
+            // GNU long name entry, then the real entry with the name truncated
+            putHeader(out, "././@LongLink", 'L', name.size() + 1);
+            putData(out, name.c_str(), name.size() + 1);
+            base = name.substr(0, 100);
+            prefix.clear();
+        }
+        std::memcpy(header, base.data(), base.size());
+        putOctal(header + 100, 8, 0644);  // mode
+        putOctal(header + 108, 8, 0);  // uid
+        putOctal(header + 116, 8, 0);  // gid
+        putOctal(header + 124, 12, size);
+        putOctal(header + 136, 12, static_cast<uint64_t>(time(nullptr)));
+        header[156] = typeflag;
+        std::memcpy(header + 257, "ustar", 6);
+        std::memcpy(header + 263, "00", 2);
+        std::memcpy(header + 345, prefix.data(), prefix.size());
+        // Checksum is computed with its own field as spaces
+        std::memset(header + 148, ' ', 8);
+        unsigned sum = 0;
+        for (const char c : header) sum += static_cast<unsigned char>(c);
+        putOctal(header + 148, 7, sum);
+        out.append(header, sizeof(header));
+    }
+    static void putData(string& out, const char* datap, size_t size) {
+        out.append(datap, size);
+        out.append((512 - size % 512) % 512, '\0');  // Pad to block
+    }
+
+public:
+    void addFile(const string& filename, const string& contents, bool append) {
+        if (append) {
+            m_files[filename] += contents;
+        } else {
+            m_files[filename] = contents;
+        }
+    }
+    void write(const string& filename) {
+        string out;
+        size_t size = 0;
+        for (const auto& itr : m_files) size += 1024 + itr.first.size() + itr.second.size();
+        out.reserve(size + 1024);
+        for (const auto& itr : m_files) {
+            // Archive members are relative
+            string name = itr.first;
+            while (!name.empty() && name[0] == '/') name.erase(0, 1);
+            putHeader(out, name, '0', itr.second.size());
+            putData(out, itr.second.data(), itr.second.size());
+        }
+        out.append(1024, '\0');  // End of archive
+        FILE* const fp = fopen(filename.c_str(), "wb");
+        if (!fp || fwrite(out.data(), out.size(), 1, fp) != 1) {
+            v3fatal("Cannot write --output-archive " << filename);
+        }
+        fclose(fp);
+        m_files.clear();
+    }
+};
+
+VOutArchiveImp outArchiveImp;
+
+bool VOutArchive::enabled() { return !v3Global.opt.outputArchive().empty(); }
+void VOutArchive::addFile(const string& filename, const string& contents, bool append) {
+    outArchiveImp.addFile(filename, contents, append);
+}
+void VOutArchive::write() { outArchiveImp.write(v3Global.opt.outputArchive()); }
+
 //######################################################################
 // VInFilterImp
 
 class VInFilterImp final {
-    using StrList = VInFilter::StrList;
-
     std::map<const std::string, std::string> m_contentsMap;  // Cache of file contents
     bool m_readEof = false;  // Received EOF on read
 #ifdef INFILTER_PIPE
@@ -345,34 +439,70 @@ class VInFilterImp final {
     int m_pidStatus = 0;
     int m_writeFd = 0;  // File descriptor TO filter
     int m_readFd = 0;  // File descriptor FROM filter
+    // Statistics
+    size_t m_statMappedFiles = 0;  // Files memory mapped
+    size_t m_statMappedBytes = 0;  // Bytes memory mapped
+    size_t m_statReadBytes = 0;  // Bytes copied in through read()
 
 private:
     // METHODS
 
-    bool readContents(const string& filename, StrList& outl) {
+    bool readContents(const string& filename, string& out) {
         if (m_pid) {
-            return readContentsFilter(filename, outl);
+            return readContentsFilter(filename, out);
         } else {
-            return readContentsFile(filename, outl);
+            return readContentsFile(filename, out);
         }
     }
-    bool readContentsFile(const string& filename, StrList& outl) {
+    bool readContentsFile(const string& filename, string& out) {
         const int fd = open(filename.c_str(), O_RDONLY);
         if (fd < 0) return false;
         m_readEof = false;
-        readBlocks(fd, -1, outl);
+        readBlocks(fd, -1, out);
         close(fd);
         return true;
     }
-    bool readContentsFilter(const string& filename, StrList& outl) {
-        if (filename != "" || outl.empty()) {}  // Prevent unused
+    bool mapContentsFile(const string& filename, VInBuffer& outr) {
+        // Return false to fall back to read(), e.g. small files, pipes, or no mmap
+        if (filename != "" || outr.empty()) {}  // Prevent unused
+#ifdef INFILTER_MMAP
+        const int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat sstat;
+        bool ok = false;
+        // Small files are cheaper to read, and are cached by readWholefile
+        if (fstat(fd, &sstat) == 0 && S_ISREG(sstat.st_mode)
+            && sstat.st_size >= INFILTER_CACHE_MAX) {
+            const size_t size = sstat.st_size;
+            void* const mapp = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapp != MAP_FAILED) {
+                madvise(mapp, size, MADV_SEQUENTIAL);
+                outr = VInBuffer{std::shared_ptr<const char>{static_cast<const char*>(mapp),
+                                                             [size](const char* p) {
+                                                                 munmap(const_cast<char*>(p),
+                                                                        size);
+                                                             }},
+                                 size};
+                ++m_statMappedFiles;
+                m_statMappedBytes += size;
+                ok = true;
+            }
+        }
+        close(fd);
+        return ok;
+#else
+        return false;
+#endif
+    }
+    bool readContentsFilter(const string& filename, string& out) {
+        if (filename != "" || out.empty()) {}  // Prevent unused
 #ifdef INFILTER_PIPE
         writeFilter("read \"" + filename + "\"\n");
         const string line = readFilterLine();
         if (line.find("Content-Length") != string::npos) {
             int len = 0;
             sscanf(line.c_str(), "Content-Length: %d\n", &len);
-            readBlocks(m_readFd, len, outl);
+            readBlocks(m_readFd, len, out);
             return true;
         } else {
             if (line != "") v3error("--pipe-filter protocol error, unexpected: " << line);
@@ -397,7 +527,7 @@ private:
 #endif
     }
 
-    void readBlocks(int fd, int size, StrList& outl) {
+    void readBlocks(int fd, int size, string& out) {
         char buf[INFILTER_IPC_BUFSIZ];
         ssize_t sizegot = 0;
         while (!m_readEof && (size < 0 || size > sizegot)) {
@@ -408,8 +538,9 @@ private:
             // UINFO(9,"RD GOT g "<< got<<" e "<<errno<<" "<<strerror(errno)<<endl);
             // usleep(50*1000);
             if (got > 0) {
-                outl.push_back(string(buf, got));
+                out.append(buf, got);
                 sizegot += got;
+                m_statReadBytes += got;
             } else if (errno == EINTR || errno == EAGAIN
 #ifdef EWOULDBLOCK
                        || errno == EWOULDBLOCK
@@ -430,9 +561,8 @@ private:
         UINFO(9, "readFilterLine\n");
         string line;
         while (!m_readEof) {
-            StrList outl;
-            readBlocks(m_readFd, 1, outl);
-            const string onechar = listString(outl);
+            string onechar;
+            readBlocks(m_readFd, 1, onechar);
             line += onechar;
             if (onechar == "\n") {
                 if (line == "\n") {
@@ -569,34 +699,35 @@ private:
 protected:
     friend class VInFilter;
     // Read file contents and return it
-    bool readWholefile(const string& filename, StrList& outl) {
+    bool readWholefile(const string& filename, VInBuffer& outr) {
         const auto it = m_contentsMap.find(filename);
         if (it != m_contentsMap.end()) {
-            outl.push_back(it->second);
+            outr = VInBuffer{it->second};
             return true;
         }
-        if (!readContents(filename, outl)) return false;
-        if (listSize(outl) < INFILTER_CACHE_MAX) {
+        // Without a filter, large files are scanned straight from the mapping
+        if (!m_pid && mapContentsFile(filename, outr)) return true;
+        string out;
+        if (!readContents(filename, out)) return false;
+        if (out.size() < INFILTER_CACHE_MAX) {
             // Cache small files (only to save space)
             // It's quite common to `include "timescale" thousands of times
             // This isn't so important if it's just an open(), but filtering can be slow
-            m_contentsMap.emplace(filename, listString(outl));
+            m_contentsMap.emplace(filename, out);
         }
+        outr = VInBuffer{std::move(out)};
         return true;
     }
-    static size_t listSize(const StrList& sl) {
-        size_t out = 0;
-        for (const string& i : sl) out += i.length();
-        return out;
-    }
-    static string listString(const StrList& sl) {
-        string out;
-        for (const string& i : sl) out += i;
-        return out;
-    }
     // CONSTRUCTORS
     explicit VInFilterImp(const string& command) { start(command); }
-    ~VInFilterImp() { stop(); }
+    ~VInFilterImp() {
+        stop();
+        if (v3Global.opt.stats()) {
+            V3Stats::addStat("Input, files memory mapped", m_statMappedFiles);
+            V3Stats::addStat("Input, bytes memory mapped", m_statMappedBytes);
+            V3Stats::addStat("Input, bytes read", m_statReadBytes);
+        }
+    }
 };
 
 //######################################################################
@@ -608,9 +739,9 @@ VInFilter::~VInFilter() {
     if (m_impp) VL_DO_CLEAR(delete m_impp, m_impp = nullptr);
 }
 
-bool VInFilter::readWholefile(const string& filename, VInFilter::StrList& outl) {
+bool VInFilter::readWholefile(const string& filename, VInBuffer& outr) {
     if (!m_impp) v3fatalSrc("readWholefile on invalid filter");
-    return m_impp->readWholefile(filename, outl);
+    return m_impp->readWholefile(filename, outr);
 }
 
 //######################################################################
@@ -700,7 +831,7 @@ int V3OutFormatter::endLevels(const char* strg) {
 
 void V3OutFormatter::puts(const char* strg) {
     if (!v3Global.opt.decoration()) {
-        putsOutput(strg);
+        putsOutput(strg, strlen(strg));
         return;
     }
     if (m_prependIndent && strg[0] != '\n') {
@@ -710,9 +841,12 @@ void V3OutFormatter::puts(const char* strg) {
     bool notstart = false;
     bool wordstart = true;
     bool equalsForBracket = false;  // Looking for "= {"
-    for (const char* cp = strg; *cp; ++cp) {
-        putcNoTracking(*cp);
-        if (isalpha(*cp)) {
+    // Characters are tracked one at a time, but written out in runs from spanp
+    const char* spanp = strg;
+    const char* cp = strg;
+    for (; *cp; ++cp) {
+        trackChar(*cp);
+        if (m_lang == LA_VERILOG && isalpha(*cp)) {
             if (wordstart && m_lang == LA_VERILOG && tokenNotStart(cp)) notstart = true;
             if (wordstart && m_lang == LA_VERILOG && !notstart && tokenStart(cp)) indentInc();
             if (wordstart && m_lang == LA_VERILOG && tokenEnd(cp)) indentDec();
@@ -727,6 +861,8 @@ void V3OutFormatter::puts(const char* strg) {
                 m_prependIndent = true;
             } else {
                 m_prependIndent = false;
+                putsOutput(spanp, cp + 1 - spanp);
+                spanp = cp + 1;
                 putsNoTracking(indentSpaces(endLevels(cp + 1)));
             }
             break;
@@ -741,8 +877,12 @@ void V3OutFormatter::puts(const char* strg) {
                 if (cp > strg && cp[-1] == '/' && !m_inStringLiteral) {
                     // Output ignoring contents to EOL
                     ++cp;
-                    while (*cp && cp[1] && cp[1] != '\n') putcNoTracking(*cp++);
-                    if (*cp) putcNoTracking(*cp);
+                    while (*cp && cp[1] && cp[1] != '\n') trackChar(*cp++);
+                    if (*cp) {
+                        trackChar(*cp);
+                    } else {
+                        --cp;  // Stop at the terminator
+                    }
                 }
             }
             break;
@@ -798,6 +938,7 @@ void V3OutFormatter::puts(const char* strg) {
         default: equalsForBracket = false; break;
         }
     }
+    if (cp != spanp) putsOutput(spanp, cp - spanp);
 }
 
 void V3OutFormatter::putBreakExpr() {
@@ -819,41 +960,21 @@ void V3OutFormatter::putBreak() {
 void V3OutFormatter::putsQuoted(const string& strg) {
     // Quote \ and " for use inside C programs
     // Don't use to quote a filename for #include - #include doesn't \ escape.
-    putcNoTracking('"');
-    const string quoted = quoteNameControls(strg);
-    for (const char c : quoted) putcNoTracking(c);
-    putcNoTracking('"');
+    putsNoTracking('"' + quoteNameControls(strg) + '"');
 }
 void V3OutFormatter::putsNoTracking(const string& strg) {
-    if (!v3Global.opt.decoration()) {
-        putsOutput(strg.c_str());
-        return;
-    }
+    putsNoTracking(strg.data(), strg.size());
+}
+void V3OutFormatter::putsNoTracking(const char* strg, size_t len) {
     // Don't track {}'s, probably because it's a $display format string
-    for (const char c : strg) putcNoTracking(c);
+    if (v3Global.opt.decoration()) {
+        for (const char* cp = strg; cp != strg + len; ++cp) trackChar(*cp);
+    }
+    putsOutput(strg, len);
 }
 
 void V3OutFormatter::putcNoTracking(char chr) {
-    if (!v3Global.opt.decoration()) {
-        putcOutput(chr);
-        return;
-    }
-    switch (chr) {
-    case '\n':
-        ++m_lineno;
-        m_column = 0;
-        m_nobreak = true;
-        break;
-    case '\t': m_column = ((m_column + 9) / 8) * 8; break;
-    case ' ':
-    case '(':
-    case '|':
-    case '&': ++m_column; break;
-    default:
-        ++m_column;
-        m_nobreak = false;
-        break;
-    }
+    if (v3Global.opt.decoration()) trackChar(chr);
     putcOutput(chr);
 }
 
@@ -923,7 +1044,9 @@ void V3OutFormatter::printf(const char* fmt...) {
 V3OutFile::V3OutFile(const string& filename, V3OutFormatter::Language lang)
     : V3OutFormatter{filename, lang}
     , m_bufferp{new std::array<char, WRITE_BUFFER_SIZE_BYTES>{}} {
-    if ((m_fp = V3File::new_fopen_w(filename)) == nullptr) {
+    if (VOutArchive::enabled()) {
+        V3File::addTgtDepend(filename);
+    } else if ((m_fp = V3File::new_fopen_w(filename)) == nullptr) {
         v3fatal("Cannot write " << filename);
     }
 }
@@ -931,7 +1054,11 @@ V3OutFile::V3OutFile(const string& filename, V3OutFormatter::Language lang)
 V3OutFile::~V3OutFile() {
     writeBlock();
 
-    if (m_fp) fclose(m_fp);
+    if (m_fp) {
+        fclose(m_fp);
+    } else {
+        VOutArchive::addFile(filename(), m_archiveText);
+    }
     m_fp = nullptr;
 }
 
@@ -27,9 +27,37 @@
 #include <list>
 #include <memory>
 #include <set>
+#include <sstream>
 #include <stack>
 #include <vector>
 
+//============================================================================
+// VOutArchive: Generated files held in memory, see --output-archive
+
+class VOutArchive final {
+public:
+    // Output files go to memory rather than the filesystem
+    static bool enabled();
+    // Add contents of a file, replacing or appending to any earlier contents
+    static void addFile(const string& filename, const string& contents, bool append = false);
+    // Write all files as one tar archive to the --output-archive filename
+    static void write();
+};
+
+// Output file stream that is added to the VOutArchive when deleted
+class VOutArchiveStream final : public std::ofstream {
+    std::stringbuf m_buf;  // Contents
+    const string m_filename;  // Filename in archive
+    const bool m_append;  // Append to existing contents
+public:
+    VOutArchiveStream(const string& filename, bool append)
+        : m_filename{filename}
+        , m_append{append} {
+        std::ostream::rdbuf(&m_buf);
+    }
+    ~VOutArchiveStream() override { VOutArchive::addFile(m_filename, m_buf.str(), m_append); }
+};
+
 //============================================================================
 // V3File: Create streams, recording dependency information
 
@@ -44,6 +72,7 @@ public:
     }
     static std::ofstream* new_ofstream(const string& filename, bool append = false) {
         addTgtDepend(filename);
+        if (VOutArchive::enabled()) return new VOutArchiveStream{filename, append};
         return new_ofstream_nodepend(filename, append);
     }
     static std::ofstream* new_ofstream_nodepend(const string& filename, bool append = false) {
@@ -73,17 +102,43 @@ public:
     static void createMakeDir();
 };
 
+//============================================================================
+// VInBuffer: Input text not yet consumed, either owned or a read-only view
+// of a memory mapped file.  Copies share the mapping.
+
+class VInBuffer final {
+    // MEMBERS
+    string m_text;  // Owned text, when not mapped
+    std::shared_ptr<const char> m_mapp;  // Mapping holding the text, when mapped
+    size_t m_size = 0;  // Mapped bytes
+    size_t m_offset = 0;  // Bytes already consumed
+
+public:
+    // CONSTRUCTORS
+    VInBuffer() = default;
+    explicit VInBuffer(string text)
+        : m_text{std::move(text)} {}
+    VInBuffer(std::shared_ptr<const char> mapp, size_t size)
+        : m_mapp{std::move(mapp)}
+        , m_size{size} {}
+
+    // METHODS
+    bool mapped() const { return m_mapp != nullptr; }
+    // Reference to the unconsumed part of the mapping, keeping it mapped
+    std::shared_ptr<const char> mapping() const { return {m_mapp, data()}; }
+    const char* data() const { return (m_mapp ? m_mapp.get() : m_text.data()) + m_offset; }
+    size_t size() const { return (m_mapp ? m_size : m_text.size()) - m_offset; }
+    bool empty() const { return size() == 0; }
+    void consume(size_t len) { m_offset += len; }  // Drop len bytes from the front
+    string str() const { return string(data(), size()); }
+};
+
 //============================================================================
 // VInFilter: Read a input file, possibly filtering it, and caching contents
 
 class VInFilterImp;
 
 class VInFilter final {
-public:
-    // TYPES
-    using StrList = std::list<std::string>;
-
-private:
     VInFilterImp* m_impp;
 
     // CONSTRUCTORS
@@ -95,7 +150,8 @@ public:
 
     // METHODS
     // Read file contents and return it.  Return true on success.
-    bool readWholefile(const string& filename, StrList& outl);
+    // Large unfiltered files are memory mapped rather than copied.
+    bool readWholefile(const string& filename, VInBuffer& outr);
 };
 
 //============================================================================
@@ -130,6 +186,25 @@ private:
 
     int endLevels(const char* strg);
     void putcNoTracking(char chr);
+    void putsNoTracking(const char* strg, size_t len);
+    void trackChar(char chr) {
+        switch (chr) {
+        case '\n':
+            ++m_lineno;
+            m_column = 0;
+            m_nobreak = true;
+            break;
+        case '\t': m_column = ((m_column + 9) / 8) * 8; break;
+        case ' ':
+        case '(':
+        case '|':
+        case '&': ++m_column; break;
+        default:
+            ++m_column;
+            m_nobreak = false;
+            break;
+        }
+    }
 
 public:
     V3OutFormatter(const string& filename, Language lang);
@@ -179,7 +254,7 @@ public:
 
     // CALLBACKS - MUST OVERRIDE
     virtual void putcOutput(char chr) = 0;
-    virtual void putsOutput(const char* str) = 0;
+    virtual void putsOutput(const char* str, size_t len) = 0;
 };
 
 //============================================================================
@@ -198,6 +273,7 @@ class V3OutFile VL_NOT_FINAL : public V3OutFormatter {
     std::unique_ptr<std::array<char, WRITE_BUFFER_SIZE_BYTES>> m_bufferp;  // Write buffer
     std::size_t m_usedBytes = 0;  // Number of bytes stored in m_bufferp
     FILE* m_fp = nullptr;
+    string m_archiveText;  // Contents for VOutArchive, when enabled
 
 public:
     V3OutFile(const string& filename, V3OutFormatter::Language lang);
@@ -211,17 +287,22 @@ public:
 
 private:
     void writeBlock() {
-        if (VL_LIKELY(m_usedBytes > 0)) fwrite(m_bufferp->data(), m_usedBytes, 1, m_fp);
+        if (VL_LIKELY(m_usedBytes > 0)) {
+            if (m_fp) {
+                fwrite(m_bufferp->data(), m_usedBytes, 1, m_fp);
+            } else {
+                m_archiveText.append(m_bufferp->data(), m_usedBytes);
+            }
+        }
         m_usedBytes = 0;
     }
 
     // CALLBACKS
     void putcOutput(char chr) override {
-        m_bufferp->at(m_usedBytes++) = chr;
+        (*m_bufferp)[m_usedBytes++] = chr;
         if (VL_UNLIKELY(m_usedBytes >= WRITE_BUFFER_SIZE_BYTES)) writeBlock();
     }
-    void putsOutput(const char* str) override {
-        std::size_t len = strlen(str);
+    void putsOutput(const char* str, std::size_t len) override {
         std::size_t availableBytes = WRITE_BUFFER_SIZE_BYTES - m_usedBytes;
         while (VL_UNLIKELY(len >= availableBytes)) {
             std::memcpy(m_bufferp->data() + m_usedBytes, str, availableBytes);
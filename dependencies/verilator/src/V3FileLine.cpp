@@ -30,6 +30,7 @@
 // clang-format on
 
 #include <algorithm>
+#include <cstring>
 #include <iomanip>
 #include <limits>
 #include <unordered_set>
@@ -128,44 +129,59 @@ FileLineSingleton::msgEnSetIdx_t FileLineSingleton::msgEnAnd(msgEnSetIdx_t lhsId
 // ######################################################################
 //  VFileContents class functions
 
-void VFileContent::pushText(const string& text) {
-    if (m_lines.size() == 0) {
-        m_lines.emplace_back("");  // no such thing as line [0]
-        m_lines.emplace_back("");  // start with no leftover
+void VFileContent::indexLines(size_t offset, const char* textp, size_t len) {
+    // Lines are only materialized by getLine, here just record where each starts.
+    // Any leftover text is on the last line (might be "")
+    if (m_lineStarts.empty()) {
+        m_lineStarts.push_back(0);  // no such thing as line [0]
+        m_lineStarts.push_back(0);  // start with no leftover
     }
+    const char* cp = textp;
+    const char* const endp = textp + len;
+    while (const char* const nlp = static_cast<const char*>(std::memchr(cp, '\n', endp - cp))) {
+        cp = nlp + 1;  // Keeps newline
+        m_lineStarts.push_back(offset + (cp - textp));
+    }
+}
 
-    // Any leftover text is stored on largest line (might be "")
-    const string leftover = m_lines.back() + text;
-    m_lines.pop_back();
+void VFileContent::pushText(const char* textp, size_t len) {
+    if (m_mapp) {
+        // Can't append to a mapping, so fall back to a copy
+        m_text.assign(m_mapp.get(), m_mapp.get() + m_mapSize);
+        m_mapp = nullptr;
+        m_mapSize = 0;
+    }
+    UINFO(9, "PushStream[ct" << m_id << "]: " << string(textp, len));
+    const size_t offset = m_text.size();
+    m_text.insert(m_text.end(), textp, textp + len);
+    indexLines(offset, textp, len);
+}
 
-    // Insert line-by-line
-    string::size_type line_start = 0;
-    while (true) {
-        const string::size_type line_end = leftover.find('\n', line_start);
-        if (line_end != string::npos) {
-            const string oneline(leftover, line_start, line_end - line_start + 1);
-            m_lines.push_back(oneline);  // Keeps newline
-            UINFO(9, "PushStream[ct" << m_id << "+" << (m_lines.size() - 1) << "]: " << oneline);
-            line_start = line_end + 1;
-        } else {
-            break;
-        }
+void VFileContent::pushMapped(std::shared_ptr<const char> mapp, size_t size) {
+    if (!m_lineStarts.empty()) {
+        pushText(mapp.get(), size);
+        return;
     }
-    // Keep leftover for next time
-    m_lines.emplace_back(string(leftover, line_start));  // Might be ""
+    m_mapp = std::move(mapp);
+    m_mapSize = size;
+    indexLines(0, m_mapp.get(), size);
 }
 
 string VFileContent::getLine(int lineno) const VL_MT_SAFE {
     // Return error text rather than asserting so the user isn't left without a message
     // cppcheck-suppress negativeContainerIndex
-    if (VL_UNCOVERABLE(lineno < 0 || lineno >= (int)m_lines.size())) {
+    if (VL_UNCOVERABLE(lineno < 0 || lineno >= (int)m_lineStarts.size())) {
         if (debug() || v3Global.opt.debugCheck()) {
             return ("%Error-internal-contents-bad-ct" + cvtToStr(m_id) + "-ln" + cvtToStr(lineno));
         } else {
             return "";
         }
     }
-    string text = m_lines[lineno];
+    const size_t begin = m_lineStarts[lineno];
+    const size_t end
+        = (lineno + 1 < (int)m_lineStarts.size()) ? m_lineStarts[lineno + 1] : textSize();
+    const string text = m_mapp ? string(m_mapp.get() + begin, end - begin)
+                               : string(m_text.begin() + begin, m_text.begin() + end);
     UINFO(9, "Get Stream[ct" << m_id << "+" << lineno << "]: " << text);
     return text;
 }
@@ -488,6 +504,14 @@ void FileLine::operator delete(void* objp, size_t size) {
 }
 #endif
 
+void FileLine::reset() {
+    // FileLines still held refer to the old file numbers, so there must be none in use
+    singleton().clear();
+    FileLine& defaultFl = defaultFileLine();
+    defaultFl.m_msgEnIdx = singleton().defaultMsgEnIndex();
+    defaultFl.m_filenameno = singleton().nameToNumber(builtInFilename());
+}
+
 void FileLine::deleteAllRemaining() {
 #ifdef VL_LEAK_CHECKS
     // FileLines are allocated, but never nicely freed, as it's much faster
@@ -43,6 +43,8 @@ class FileLine;
 //! source file (each with its own unique filename number).
 class FileLineSingleton final {
     friend class FileLine;
+    friend class VNCheckpointReader;
+    friend class VNCheckpointWriter;
 
     // TYPES
     using fileNameIdx_t = uint16_t;  // Increase width if 64K input files are not enough
@@ -94,11 +96,17 @@ class FileLineSingleton final {
 // All source lines from a file/stream, to enable errors to show sources
 class VFileContent final {
     friend class FileLine;
+    friend class VNCheckpointReader;
+    friend class VNCheckpointWriter;
     // MEMBERS
     int m_id;  // Content ID number
     // Reference count for sharing (shared_ptr has size overhead that we don't want)
     std::atomic<size_t> m_refCount{0};
-    std::deque<string> m_lines;  // Source text lines
+    // Source text, unless m_mapp. A deque, as growing a string would transiently double it
+    std::deque<char> m_text;
+    std::shared_ptr<const char> m_mapp;  // Mapped source file holding the text
+    size_t m_mapSize = 0;  // Size of text in m_mapp
+    std::deque<size_t> m_lineStarts;  // Offset where each line starts; no such thing as line [0]
     VFileContent() {
         static int s_id = 0;
         m_id = ++s_id;
@@ -109,9 +117,15 @@ class VFileContent final {
     void refDec() {
         if (!--m_refCount) delete this;
     }
+    size_t textSize() const { return m_mapp ? m_mapSize : m_text.size(); }
+    void indexLines(size_t offset, const char* textp, size_t len);
 
 public:
-    void pushText(const string& text);  // Add arbitrary text (need not be line-by-line)
+    // Add arbitrary text (need not be line-by-line)
+    void pushText(const char* textp, size_t len);
+    void pushText(const string& text) { pushText(text.data(), text.size()); }
+    // Add the whole text of a memory mapped file, keeping only a reference to it
+    void pushMapped(std::shared_ptr<const char> mapp, size_t size);
     string getLine(int lineno) const VL_MT_SAFE;
     string ascii() const { return "ct" + cvtToStr(m_id); }
 };
@@ -156,6 +170,8 @@ protected:
     friend class V3PreLex;
     friend class V3PreProcImp;
     friend class V3PreShellImp;
+    friend class VNCheckpointReader;
+    friend class VNCheckpointWriter;
 
 private:
     // CONSTRUCTORS
@@ -195,6 +211,7 @@ public:
     }
     FileLine* copyOrSameFileLine();
     static void deleteAllRemaining();
+    static void reset();  // Forget files and global warning settings, to Verilate again
     ~FileLine();
 #ifdef VL_LEAK_CHECKS
     static void* operator new(size_t size);
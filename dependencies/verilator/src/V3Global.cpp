@@ -20,13 +20,19 @@
 #include "V3Global.h"
 
 #include "V3Ast.h"
+#include "V3Config.h"
 #include "V3File.h"
 #include "V3HierBlock.h"
 #include "V3LinkCells.h"
+#include "V3Os.h"
 #include "V3Parse.h"
 #include "V3ParseSym.h"
+#include "V3PreProc.h"
+#include "V3PreShell.h"
 #include "V3Stats.h"
 
+#include <set>
+
 //######################################################################
 // V3Global
 
@@ -45,8 +51,25 @@ void V3Global::shutdown() {
     VL_DO_CLEAR(delete m_hierPlanp, m_hierPlanp = nullptr);  // delete nullptr is safe
 }
 
+void V3Global::reset() {
+    // Only what is listed here; see nodist/fuzzer/persistent.cpp for what is not
+    if (m_rootp) VL_DO_CLEAR(m_rootp->deleteTree(), m_rootp = nullptr);
+    shutdown();
+    *this = V3Global{};
+    V3Config::reset();
+    V3Error::reset();
+    V3PreShell::reset();
+    V3Stats::reset();
+    FileLine::reset();
+}
+
 void V3Global::checkTree() const { rootp()->checkTree(); }
 
+void V3Global::rootp(AstNetlist* newp) {
+    VL_DO_DANGLING(m_rootp->deleteTree(), m_rootp);
+    m_rootp = newp;
+}
+
 void V3Global::readFiles() {
     // NODE STATE
     //   AstNode::user4p()      // VSymEnt*    Package and typedef symbol names
@@ -56,8 +79,22 @@ void V3Global::readFiles() {
     V3ParseSym parseSyms(v3Global.rootp());  // Symbol table must be common across all parsing
 
     V3Parse parser(v3Global.rootp(), &filter, &parseSyms);
-    // Read top module
+    const bool hierForkParent
+        = v3Global.opt.hierarchical() && v3Global.opt.hierFork() && v3Global.opt.gmake()
+          && !v3Global.opt.hierChild() && v3Global.opt.hierBlocks().empty()
+          && !v3Global.opt.preprocOnly();
+    // Defines before any file, for the wrappers read by --hierarchical-fork runs
+    std::vector<V3PreProcDefine> startDefines;
+    if (hierForkParent) startDefines = V3PreShell::definesSave();
     const V3StringList& vFiles = v3Global.opt.vFiles();
+    const V3StringSet& libraryFiles = v3Global.opt.libraryFiles();
+    if (v3Global.opt.preprocJobs() > 1) {
+        std::vector<string> filenames{vFiles.begin(), vFiles.end()};
+        filenames.insert(filenames.end(), libraryFiles.begin(), libraryFiles.end());
+        V3PreShell::preprocParallel(&filter, filenames);
+    }
+
+    // Read top module
     for (const string& filename : vFiles) {
         parser.parseFile(new FileLine(FileLine::commandLineFilename()), filename, false,
                          "Cannot find file containing module: ");
@@ -66,7 +103,6 @@ void V3Global::readFiles() {
     // Read libraries
     // To be compatible with other simulators,
     // this needs to be done after the top file is read
-    const V3StringSet& libraryFiles = v3Global.opt.libraryFiles();
     for (const string& filename : libraryFiles) {
         parser.parseFile(new FileLine(FileLine::commandLineFilename()), filename, true,
                          "Cannot find file containing library module: ");
@@ -74,6 +110,52 @@ void V3Global::readFiles() {
     // v3Global.rootp()->dumpTreeFile(v3Global.debugFilename("parse.tree"));
     V3Error::abortIfErrors();
 
+    if (hierForkParent) {
+        std::set<string> parsedFiles;
+        for (const string& filename : vFiles) {
+            parsedFiles.insert(V3Os::filenameRealPath(filename));
+        }
+        for (const string& filename : libraryFiles) {
+            parsedFiles.insert(V3Os::filenameRealPath(filename));
+        }
+        if (V3HierBlockPlan::forkParsed()) {
+            // Now a child run with its own options; parse only what it adds,
+            // i.e. wrappers of the blocks below it.  Without the fork these are
+            // read first, so read them as if they were: from the defines before
+            // any input file, with a new parser for the `timescale and keyword
+            // state, and put their modules ahead of the shared ones.  Wrappers
+            // leave no defines or other state that could change the shared files.
+            const std::vector<V3PreProcDefine> endDefines = V3PreShell::definesSave();
+            V3PreShell::definesRestore(startDefines);
+            AstNode* const oldModsp = v3Global.rootp()->modulesp();
+            AstNode* lastOldModp = oldModsp;
+            while (lastOldModp && lastOldModp->nextp()) lastOldModp = lastOldModp->nextp();
+            {
+                V3Parse wrapperParser{v3Global.rootp(), &filter, &parseSyms};
+                for (const string& filename : v3Global.opt.vFiles()) {
+                    if (parsedFiles.count(V3Os::filenameRealPath(filename))) continue;
+                    wrapperParser.parseFile(new FileLine(FileLine::commandLineFilename()),
+                                            filename, false,
+                                            "Cannot find file containing module: ");
+                }
+                for (const string& filename : v3Global.opt.libraryFiles()) {
+                    if (parsedFiles.count(V3Os::filenameRealPath(filename))) continue;
+                    wrapperParser.parseFile(new FileLine(FileLine::commandLineFilename()),
+                                            filename, true,
+                                            "Cannot find file containing library module: ");
+                }
+            }
+            V3Error::abortIfErrors();
+            V3PreShell::definesRestore(endDefines);
+            if (lastOldModp && lastOldModp->nextp()) {
+                AstNode* const newModsp = lastOldModp->nextp()->unlinkFrBackWithNext();
+                v3Global.rootp()->modulesp()->unlinkFrBackWithNext();
+                v3Global.rootp()->addModulesp(VN_AS(newModsp, NodeModule));
+                v3Global.rootp()->addModulesp(VN_AS(oldModsp, NodeModule));
+            }
+        }
+    }
+
     if (!v3Global.opt.preprocOnly()) {
         // Resolve all modules cells refer to
         V3LinkCells::link(v3Global.rootp(), &filter, &parseSyms);
@@ -126,6 +126,7 @@ public:
     void boot();
     void clear();
     void shutdown();  // Release allocated resorces
+    void reset();  // Return to before boot(), to Verilate again in the same process
     // ACCESSORS (general)
     AstNetlist* rootp() const VL_MT_SAFE { return m_rootp; }
     VWidthMinUsage widthMinUsage() const { return m_widthMinUsage; }
@@ -134,6 +135,7 @@ public:
 
     // METHODS
     void readFiles();
+    void rootp(AstNetlist* newp);  // Replace the whole netlist, from V3Checkpoint
     void checkTree() const;
     static void dumpCheckGlobalTree(const string& stagename, int newNumber = 0,
                                     bool doDump = true);
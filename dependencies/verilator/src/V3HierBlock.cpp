@@ -26,7 +26,8 @@
 // 1) Find modules marked by /*verilator hier_block*/ metacomment
 // 2) Generate ${prefix}_hier.mk to create protected-lib for hierarchical blocks and
 //    final Verilation to process the top module, that refers wrappers
-// 3) Call child Verilator process via ${prefix}_hier.mk
+// 3) Call child Verilator process via ${prefix}_hier.mk, or with --hierarchical-fork,
+//    fork them from a copy of run a) kept right after parsing (see forkParsed())
 //
 // There are 3 kinds of Verilator run.
 // a) To create ${prefix}_hier.mk (--hierarchical)
@@ -81,11 +82,24 @@
 #include "V3Stats.h"
 #include "V3String.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <map>
 #include <memory>
 #include <sstream>
 #include <utility>
 #include <vector>
 
+// clang-format off
+#if !defined(_WIN32) && !defined(__MINGW32__)
+# define V3HIERBLOCK_FORK
+# include <fcntl.h>
+# include <sys/wait.h>
+# include <unistd.h>
+#endif
+// clang-format on
+
 VL_DEFINE_DEBUG_FUNCTIONS;
 
 static string V3HierCommandArgsFileName(const string& prefix, bool forCMake) {
@@ -435,3 +449,165 @@ void V3HierBlockPlan::writeCommandArgsFiles(bool forCMake) const {
 string V3HierBlockPlan::topCommandArgsFileName(bool forCMake) {
     return V3HierCommandArgsFileName(v3Global.opt.prefix(), forCMake);
 }
+
+//######################################################################
+// Forked hierarchical Verilation (--hierarchical-fork)
+//
+// Each child run parses the same input files as run a), plus the wrappers
+// of the blocks below it.  So run a) forks a process right after parsing
+// which keeps that netlist.  For each child run the process forks again,
+// the new process reparses its options from the argument file, parses the
+// wrappers in front of the shared modules so they take precedence, and
+// carries on with V3LinkCells as if started from the command line.
+
+#ifdef V3HIERBLOCK_FORK
+// Run a) writes argument files to Verilate, one per line
+static int s_hierRequestFd = -1;
+// The forked process writes back "<exit code> <argument file>" per finished run
+static int s_hierResponseFd = -1;
+
+static bool hierReadLine(int fd, string& line) {
+    // Lines are short, and written by a single write() each
+    line.clear();
+    while (true) {
+        char c;
+        const ssize_t got = ::read(fd, &c, 1);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return false;
+        if (c == '\n') return true;
+        line += c;
+    }
+}
+
+static void hierWriteLine(int fd, const string& line) {
+    const string buf = line + "\n";
+    while (::write(fd, buf.data(), buf.size()) < 0 && errno == EINTR) {}
+}
+
+static void hierPipe(int fds[2]) {
+    if (VL_UNCOVERABLE(::pipe(fds) < 0)) {
+        v3fatal("Failed to create pipe: " << std::strerror(errno));  // LCOV_EXCL_LINE
+    }
+    // Not to be inherited by make or the C++ compiler
+    for (int i = 0; i < 2; ++i) ::fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+}
+#endif
+
+bool V3HierBlockPlan::forkParsed() {
+#ifdef V3HIERBLOCK_FORK
+    int requestFds[2];
+    int responseFds[2];
+    hierPipe(requestFds);
+    hierPipe(responseFds);
+    if (V3Os::forkProcess()) {
+        ::close(requestFds[0]);
+        ::close(responseFds[1]);
+        s_hierRequestFd = requestFds[1];
+        s_hierResponseFd = responseFds[0];
+        return false;
+    }
+    ::close(requestFds[1]);
+    ::close(responseFds[0]);
+    string argsFile;
+    // Exit once run a) closes the pipe, at the latest when it exits
+    while (hierReadLine(requestFds[0], argsFile)) {
+        while (::waitpid(-1, nullptr, WNOHANG) > 0) {}
+        if (V3Os::forkProcess()) continue;
+        // Wait for the child run in a separate process, so the exit code
+        // is reported even if the child run crashes
+        ::close(requestFds[0]);
+        const int pid = V3Os::forkProcess();
+        if (!pid) {
+            ::close(responseFds[1]);
+            UINFO(1, "Forked hierarchical Verilation of " << argsFile << endl);
+            v3Global.opt.restartOpts(new FileLine{FileLine::commandLineFilename()},
+                                     {"-f", argsFile});
+            V3Error::abortIfErrors();
+            // As verilate() would have before parsing
+            if (v3Global.opt.skipIdentical().isTrue()
+                && V3File::checkTimes(v3Global.opt.hierTopDataDir() + "/"
+                                          + v3Global.opt.prefix() + "__verFiles.dat",
+                                      v3Global.opt.commandArgString())) {
+                UINFO(1, "--skip-identical: No change to any source files, exiting\n");
+                std::exit(0);
+            }
+            return true;
+        }
+        const int exitCode = V3Os::waitProcess(pid);
+        hierWriteLine(responseFds[1], cvtToStr(exitCode) + " " + argsFile);
+        ::_exit(0);
+    }
+    ::_exit(0);
+#else
+    v3fatal("Unsupported: --hierarchical-fork is not available on this platform");
+    return false;  // LCOV_EXCL_LINE
+#endif
+}
+
+void V3HierBlockPlan::verilateForked() const {
+#ifdef V3HIERBLOCK_FORK
+    UASSERT(s_hierRequestFd >= 0, "forkParsed() must be called before");
+    using RunMap = std::map<string, const V3HierBlock*>;
+    RunMap running;  // Key is the argument file
+    std::unordered_set<const V3HierBlock*> done;
+    const auto launch = [&](const string& argsFile, const V3HierBlock* blockp) {
+        UINFO(1, "Start hierarchical Verilation of " << argsFile << endl);
+        hierWriteLine(s_hierRequestFd, argsFile);
+        running.emplace(argsFile, blockp);
+    };
+    std::vector<string> failed;  // Argument files of runs that failed
+    const auto finish = [&]() {
+        string line;
+        if (!hierReadLine(s_hierResponseFd, line)) {
+            v3fatal("Process for --hierarchical-fork exited unexpectedly");
+        }
+        const string::size_type pos = line.find(' ');
+        const int exitCode = std::atoi(line.substr(0, pos).c_str());
+        const string argsFile = line.substr(pos + 1);
+        const auto it = running.find(argsFile);
+        UASSERT(it != running.end(), "Unknown argument file " << argsFile);
+        if (exitCode != 0) {
+            v3error("Verilation of " << argsFile << " exited with " << exitCode);
+            failed.push_back(argsFile);
+        } else {
+            done.insert(it->second);
+        }
+        running.erase(it);
+    };
+
+    // Leaf first, each block once all blocks below it are done.  After a
+    // failure start nothing more, but wait for the runs in progress so each
+    // failure is reported and no run outlives this process.
+    const size_t jobs = std::max(1, v3Global.opt.buildJobs());
+    HierVector waiting = hierBlocksSorted();
+    while ((!waiting.empty() && failed.empty()) || !running.empty()) {
+        for (auto it = waiting.begin();
+             it != waiting.end() && failed.empty() && running.size() < jobs;) {
+            const V3HierBlock::HierBlockSet& children = (*it)->children();
+            if (std::all_of(children.begin(), children.end(),
+                            [&](const V3HierBlock* childp) { return done.count(childp); })) {
+                launch((*it)->commandArgsFileName(false), *it);
+                it = waiting.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        finish();
+    }
+    if (failed.empty()) {
+        launch(topCommandArgsFileName(false), nullptr);
+        finish();
+    }
+
+    // Let the process from forkParsed() exit
+    ::close(s_hierRequestFd);
+    ::close(s_hierResponseFd);
+    s_hierRequestFd = -1;
+    s_hierResponseFd = -1;
+    if (!failed.empty()) {
+        v3fatalExit("Hierarchical Verilation failed, " << failed.size() << " of "
+                                                        << (failed.size() + done.size())
+                                                        << " runs exited with errors");
+    }
+#endif
+}
@@ -123,6 +123,13 @@ public:
     static string topCommandArgsFileName(bool forCMake);
 
     static void createPlan(AstNetlist* nodep);
+
+    // For --hierarchical-fork
+    // After parsing, leave a process holding the parsed design to fork child runs from.
+    // Returns false here, and true in each forked child run with its options applied.
+    static bool forkParsed();
+    // Verilate hierarchical blocks then the top module in processes from forkParsed()
+    void verilateForked() const;
 };
 
 #endif  // guard
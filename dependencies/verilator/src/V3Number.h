@@ -332,6 +332,9 @@ private:
 };
 
 class V3Number final {
+    friend class VNCheckpointReader;
+    friend class VNCheckpointWriter;
+
     // TYPES
     using ValueAndX = V3NumberData::ValueAndX;
     using V3NumberDataType = V3NumberData::V3NumberDataType;
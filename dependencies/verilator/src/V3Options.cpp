@@ -38,6 +38,7 @@
 #include <cctype>
 #include <dirent.h>
 #include <fcntl.h>
+#include <limits>
 #include <list>
 #include <map>
 #include <memory>
@@ -64,6 +65,8 @@ public:
 
     // STATE
     std::list<string> m_allArgs;  // List of every argument encountered
+    std::vector<string> m_cmdArgs;  // Arguments to parseOpts, before -f expansion
+    std::vector<string> m_frontendArgs;  // Arguments not only affecting the backend
     std::list<string> m_incDirUsers;  // Include directories (ordered)
     std::set<string> m_incDirUserSet;  // Include directories (for removing duplicates)
     std::list<string> m_incDirFallbacks;  // Include directories (ordered)
@@ -72,6 +75,7 @@ public:
     std::list<string> m_libExtVs;  // Library extensions (ordered)
     std::set<string> m_libExtVSet;  // Library extensions (for removing duplicates)
     DirMap m_dirMap;  // Directory listing
+    std::map<const string, bool> m_fileProbes;  // fileExists() filenames, and if found
 
     // ACCESSOR METHODS
     void addIncDirUser(const string& incdir) {
@@ -492,11 +496,14 @@ string V3Options::fileExists(const string& filename) {
     const std::set<string>* filesetp = &(diriter->second);
     const auto fileiter = filesetp->find(basename);
     if (fileiter == filesetp->end()) {
+        fileProbed(filename, false);
         return "";  // Not found
     }
     // Check if it is a directory, ignore if so
     string filenameOut = V3Os::filenameFromDirBase(dir, basename);
-    if (!fileStatNormal(filenameOut)) return "";  // Directory
+    const bool found = fileStatNormal(filenameOut);
+    fileProbed(filename, found);
+    if (!found) return "";  // Directory
     return filenameOut;
 }
 
@@ -524,7 +531,8 @@ int V3Options::stripOptionsForChildRun(const string& opt, bool forTop) {
         return 2;
     }
     if (opt == "build" || (!forTop && (opt == "cc" || opt == "exe" || opt == "sc"))
-        || opt == "hierarchical" || (opt.length() > 2 && opt.substr(0, 2) == "G=")) {
+        || opt == "hierarchical" || opt == "hierarchical-fork" || opt == "no-hierarchical-fork"
+        || (opt.length() > 2 && opt.substr(0, 2) == "G=")) {
         return 1;
     }
     return 0;
@@ -752,9 +760,10 @@ void V3Options::notify() {
     FileLine* const cmdfl = new FileLine{FileLine::commandLineFilename()};
 
     if (!outFormatOk() && v3Global.opt.main()) ccSet();  // --main implies --cc if not provided
-    if (!outFormatOk() && !cdc() && !dpiHdrOnly() && !lintOnly() && !preprocOnly() && !xmlOnly()) {
-        v3fatal("verilator: Need --binary, --cc, --sc, --cdc, --dpi-hdr-only, --lint-only, "
-                "--xml-only or --E option");
+    if (!outFormatOk() && !cdc() && !dpiHdrOnly() && !lintOnly() && !preprocOnly() && !xmlOnly()
+        && evalPatterns().empty() && !smt2()) {
+        v3fatal("verilator: Need --binary, --cc, --sc, --cdc, --dpi-hdr-only, --eval-patterns, "
+                "--lint-only, --smt2, --xml-only or --E option");
     }
 
     if (cdc()) {
@@ -796,10 +805,44 @@ void V3Options::notify() {
         }
     }
 
+    if (!outputArchive().empty() && (build() || hierarchical() || !forkConfigs().empty())) {
+        cmdfl->v3error("--output-archive not usable with --build, --hierarchical or "
+                       "--fork-config");
+    }
+
+    if (!evalPatterns().empty()
+        && (build() || hierarchical() || lintOnly() || xmlOnly() || !forkConfigs().empty())) {
+        cmdfl->v3error("--eval-patterns not usable with --build, --hierarchical, --lint-only, "
+                       "--xml-only or --fork-config");
+    }
+
+    if (smt2() && (lintOnly() || xmlOnly() || !evalPatterns().empty() || hierarchical())) {
+        cmdfl->v3error("--smt2 not usable with --lint-only, --xml-only, --eval-patterns or "
+                       "--hierarchical");
+    }
+    if (smt2()) {
+        // Lookup tables would be arrays indexed by the inputs, keep the logic
+        m_fTable = false;
+    }
+
+    if (symExecMain()) {
+        // Emit for symbolic execution, where table lookups with symbolic
+        // indices, branches and loops each fork or widen the explored paths.
+        // These are only defaults, options given on the command line win.
+        if (!m_fTableSet) m_fTable = false;
+        if (!m_fMergeCondSet) m_fMergeCond = false;
+        if (!m_fReloopSet) m_fReloop = false;
+        if (!m_expandLimitSet) m_expandLimit = std::numeric_limits<int>::max();
+    }
+
     // Default some options if not turned on or off
     if (v3Global.opt.skipIdentical().isDefault()) {
         v3Global.opt.m_skipIdentical.setTrueOrFalse(  //
             !v3Global.opt.cdc()  //
+            && v3Global.opt.evalPatterns().empty()  //
+            && (v3Global.opt.outFormatOk() || !v3Global.opt.smt2())  //
+            && v3Global.opt.outputArchive().empty()  //
+            && v3Global.opt.forkConfigs().empty()  //
             && !v3Global.opt.dpiHdrOnly()  //
             && !v3Global.opt.lintOnly()  //
             && !v3Global.opt.preprocOnly()  //
@@ -808,6 +851,8 @@ void V3Options::notify() {
     if (v3Global.opt.makeDepend().isDefault()) {
         v3Global.opt.m_makeDepend.setTrueOrFalse(  //
             !v3Global.opt.cdc()  //
+            && v3Global.opt.evalPatterns().empty()  //
+            && (v3Global.opt.outFormatOk() || !v3Global.opt.smt2())  //
             && !v3Global.opt.dpiHdrOnly()  //
             && !v3Global.opt.lintOnly()  //
             && !v3Global.opt.preprocOnly()  //
@@ -825,10 +870,6 @@ void V3Options::notify() {
     UASSERT(!(useTraceParallel() && useTraceOffload()),
             "Cannot use both parallel and offloaded tracing");
 
-    // Default split limits if not specified
-    if (m_outputSplitCFuncs < 0) m_outputSplitCFuncs = m_outputSplit;
-    if (m_outputSplitCTrace < 0) m_outputSplitCTrace = m_outputSplit;
-
     if (v3Global.opt.main() && v3Global.opt.systemC()) {
         cmdfl->v3warn(E_UNSUPPORTED,
                       "--main not usable with SystemC. Suggest see examples for sc_main().");
@@ -838,6 +879,17 @@ void V3Options::notify() {
         cmdfl->v3error("--coverage and --savable not supported together");
     }
 
+    if (!forkConfigs().empty()
+        && (lintOnly() || xmlOnly() || preprocOnly() || dpiHdrOnly() || cdc() || hierarchical())) {
+        cmdfl->v3error("--fork-config not usable with --lint-only, --xml-only, -E, "
+                       "--dpi-hdr-only, --cdc or --hierarchical");
+    }
+    if (!checkpointDir().empty()
+        && (lintOnly() || xmlOnly() || preprocOnly() || dpiHdrOnly() || cdc() || hierarchical())) {
+        cmdfl->v3error("--checkpoint-dir not usable with --lint-only, --xml-only, -E, "
+                       "--dpi-hdr-only, --cdc or --hierarchical");
+    }
+
     // Mark options as available
     m_available = true;
 
@@ -910,12 +962,66 @@ string V3Options::argString(int argc, char** argv) {
     return opts;
 }
 
+const std::vector<string>& V3Options::commandArgs() const VL_MT_SAFE {
+    return m_impp->m_cmdArgs;
+}
+
+string V3Options::commandArgString() const {
+    string opts;
+    for (const string& arg : m_impp->m_cmdArgs) {
+        if (!opts.empty()) opts += " ";
+        opts += arg;
+    }
+    return opts;
+}
+
+const std::vector<string>& V3Options::frontendArgs() const { return m_impp->m_frontendArgs; }
+
+const std::map<const string, bool>& V3Options::fileProbes() const { return m_impp->m_fileProbes; }
+
+void V3Options::fileProbed(const string& filename, bool found) {
+    m_impp->m_fileProbes[filename] = found;
+}
+
+static bool isBackendOption(const char* optp) {
+    // Options only used by passes after V3Width::widthCommit, so the
+    // elaborated netlist kept by --checkpoint-dir does not depend on them.
+    // Everything else, including unknown future options, is keyed. V3Const
+    // also runs during elaboration, so -fassemble, -fconst and
+    // -fconst-bit-op-tree, and -O which sets them, are keyed.
+    static const std::set<string> s_backendOpts{
+        "-CFLAGS", "-LDFLAGS", "-MAKEFLAGS", "-MMD", "-MP", "-Mdir", "-build", "-build-jobs",
+        "-checkpoint-dir", "-converge-limit", "-exe", "-expand-limit", "-f",
+        "-F", "-facyc-simp", "-fcase", "-fcombine", "-fconst-before-dfg", "-fdedup", "-fdfg",
+        "-fdfg-peephole", "-fdfg-post-inline", "-fdfg-pre-inline", "-fexpand", "-fgate",
+        "-finline", "-flatten", "-flife", "-flife-post", "-flocalize", "-fmerge-cond",
+        "-fmerge-cond-motion", "-fmerge-const-pool", "-fnba-queue", "-fork-config", "-freloop",
+        "-freorder", "-fsplit", "-fsubst", "-fsubst-const", "-ftable", "-ftrace-vector",
+        "-gate-stmts", "-inline-mult", "-main", "-make", "-o", "-output-archive", "-output-split",
+        "-output-split-cfuncs", "-output-split-ctrace", "-pch", "-prof-c", "-prof-cfuncs",
+        "-prof-exec", "-prof-pgo", "-reloop-limit", "-scc-iterate", "-skip-identical", "-smt2",
+        "-stats", "-stats-vars", "-sym-exec-main", "-threads", "-waiver-output"};
+    if (optp[0] == '-' && optp[1] == '-') ++optp;
+    if (s_backendOpts.count(optp)) return true;
+    if (VString::startsWith(optp, "-no-") && s_backendOpts.count(optp + std::strlen("-no"))) {
+        return true;
+    }
+    if (VString::startsWith(optp, "-fno-")
+        && s_backendOpts.count("-f" + string{optp + std::strlen("-fno-")})) {
+        return true;
+    }
+    // -f[no-]dfg-peephole-<optimization>
+    return VString::startsWith(optp, "-fdfg-peephole-")
+           || VString::startsWith(optp, "-fno-dfg-peephole-");
+}
+
 //######################################################################
 // V3 Options Parsing
 
 void V3Options::parseOpts(FileLine* fl, int argc, char** argv) {
     // Parse all options
     // Initial entry point from Verilator.cpp
+    m_impp->m_cmdArgs.assign(argv, argv + argc);
     parseOptsList(fl, ".", argc, argv);
 
     // Default certain options and error check
@@ -1059,6 +1165,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
     DECL_OPTION("-CFLAGS", CbVal, callStrSetter(&V3Options::addCFlags));
     DECL_OPTION("-cc", CbCall, [this]() { ccSet(); });
     DECL_OPTION("-cdc", OnOff, &m_cdc);
+    DECL_OPTION("-checkpoint-dir", Set, &m_checkpointDir);
     DECL_OPTION("-clk", CbVal, callStrSetter(&V3Options::addClocker));
     DECL_OPTION("-no-clk", CbVal, callStrSetter(&V3Options::addNoClocker));
     DECL_OPTION("-comp-limit-blocks", Set, &m_compLimitBlocks).undocumented();
@@ -1126,9 +1233,12 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
     });
     DECL_OPTION("-E", Set, &m_preprocOnly);
     DECL_OPTION("-error-limit", CbVal, static_cast<void (*)(int)>(&V3Error::errorLimit));
+    DECL_OPTION("-eval-patterns", Set, &m_evalPatterns);
     DECL_OPTION("-exe", OnOff, &m_exe);
-    DECL_OPTION("-expand-limit", CbVal,
-                [this](const char* valp) { m_expandLimit = std::atoi(valp); });
+    DECL_OPTION("-expand-limit", CbVal, [this](const char* valp) {
+        m_expandLimit = std::atoi(valp);
+        m_expandLimitSet = true;
+    });
 
     DECL_OPTION("-F", CbVal, [this, fl, &optdir](const char* valp) {
         parseOptsFile(fl, parseFileArg(optdir, valp), true);
@@ -1139,6 +1249,9 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
         parseOptsFile(fl, parseFileArg(optdir, valp), false);
     });
     DECL_OPTION("-flatten", OnOff, &m_flatten);
+    DECL_OPTION("-fork-config", CbVal, [this, &optdir](const char* valp) {
+        m_forkConfigs.push_back(parseFileArg(optdir, valp));
+    });
     DECL_OPTION("-future0", CbVal, [this](const char* valp) { addFuture0(valp); });
     DECL_OPTION("-future1", CbVal, [this](const char* valp) { addFuture1(valp); });
 
@@ -1169,15 +1282,26 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
     DECL_OPTION("-flife", FOnOff, &m_fLife);
     DECL_OPTION("-flife-post", FOnOff, &m_fLifePost);
     DECL_OPTION("-flocalize", FOnOff, &m_fLocalize);
-    DECL_OPTION("-fmerge-cond", FOnOff, &m_fMergeCond);
+    DECL_OPTION("-fmerge-cond", CbFOnOff, [this](bool flag) {
+        m_fMergeCond = flag;
+        m_fMergeCondSet = true;
+    });
     DECL_OPTION("-fmerge-cond-motion", FOnOff, &m_fMergeCondMotion);
     DECL_OPTION("-fmerge-const-pool", FOnOff, &m_fMergeConstPool);
-    DECL_OPTION("-freloop", FOnOff, &m_fReloop);
+    DECL_OPTION("-fnba-queue", FOnOff, &m_fNbaQueue);
+    DECL_OPTION("-freloop", CbFOnOff, [this](bool flag) {
+        m_fReloop = flag;
+        m_fReloopSet = true;
+    });
     DECL_OPTION("-freorder", FOnOff, &m_fReorder);
     DECL_OPTION("-fsplit", FOnOff, &m_fSplit);
     DECL_OPTION("-fsubst", FOnOff, &m_fSubst);
     DECL_OPTION("-fsubst-const", FOnOff, &m_fSubstConst);
-    DECL_OPTION("-ftable", FOnOff, &m_fTable);
+    DECL_OPTION("-ftable", CbFOnOff, [this](bool flag) {
+        m_fTable = flag;
+        m_fTableSet = true;
+    });
+    DECL_OPTION("-ftrace-vector", FOnOff, &m_fTraceVector);
 
     DECL_OPTION("-G", CbPartialMatch, [this](const char* optp) { addParameter(optp, false); });
     DECL_OPTION("-gate-stmts", Set, &m_gateStmts);
@@ -1197,6 +1321,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
     });
 
     DECL_OPTION("-hierarchical", OnOff, &m_hierarchical);
+    DECL_OPTION("-hierarchical-fork", OnOff, &m_hierFork);
     DECL_OPTION("-hierarchical-block", CbVal, [this](const char* valp) {
         const V3HierarchicalBlockOption opt(valp);
         m_hierBlocks.emplace(opt.mangledName(), opt);
@@ -1271,7 +1396,10 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
             case '1': optimize(1); break;
             case '2': optimize(2); break;
             case '3': optimize(3); break;
-            case 'a': m_fTable = flag; break;  // == -fno-table
+            case 'a':
+                m_fTable = flag;
+                m_fTableSet = true;
+                break;  // == -fno-table
             case 'b': m_fCombine = flag; break;  // == -fno-combine
             case 'c': m_fConst = flag; break;  // == -fno-const
             case 'd': m_fDedupe = flag; break;  // == -fno-dedup
@@ -1289,8 +1417,14 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
             case 's': m_fSplit = flag; break;  // == -fno-split
             case 't': m_fLifePost = flag; break;  // == -fno-life-post
             case 'u': m_fSubst = flag; break;  // == -fno-subst
-            case 'v': m_fReloop = flag; break;  // == -fno-reloop
-            case 'w': m_fMergeCond = flag; break;  // == -fno-merge-cond
+            case 'v':
+                m_fReloop = flag;
+                m_fReloopSet = true;
+                break;  // == -fno-reloop
+            case 'w':
+                m_fMergeCond = flag;
+                m_fMergeCondSet = true;
+                break;  // == -fno-merge-cond
             case 'x': m_fExpand = flag; break;  // == -fno-expand
             case 'y': m_fAcycSimp = flag; break;  // == -fno-acyc-simp
             case 'z': m_fLocalize = flag; break;  // == -fno-localize
@@ -1304,6 +1438,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
     DECL_OPTION("-order-clock-delay", CbOnOff, [fl](bool /*flag*/) {
         fl->v3warn(DEPRECATED, "Option order-clock-delay is deprecated and has no effect.");
     });
+    DECL_OPTION("-output-archive", Set, &m_outputArchive);
     DECL_OPTION("-output-split", Set, &m_outputSplit);
     DECL_OPTION("-output-split-cfuncs", CbVal, [this, fl](const char* valp) {
         m_outputSplitCFuncs = std::atoi(valp);
@@ -1321,6 +1456,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
     DECL_OPTION("-P", Set, &m_preprocNoLine);
     DECL_OPTION("-pvalue+", CbPartialMatch,
                 [this](const char* varp) { addParameter(varp, false); });
+    DECL_OPTION("-pch", OnOff, &m_pch);
     DECL_OPTION("-pins64", CbCall, [this]() { m_pinsBv = 65; });
     DECL_OPTION("-no-pins64", CbCall, [this]() { m_pinsBv = 33; });
     DECL_OPTION("-pins-bv", CbVal, [this, fl](const char* valp) {
@@ -1339,6 +1475,18 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
     DECL_OPTION("-pipe-filter", Set, &m_pipeFilter);
     DECL_OPTION("-pp-comments", OnOff, &m_ppComments);
     DECL_OPTION("-prefix", Set, &m_prefix);
+    DECL_OPTION("-preproc-cache-dir", Set, &m_preprocCacheDir);
+    DECL_OPTION("-preproc-jobs", CbVal, [this, fl](const char* valp) {
+        int val = std::atoi(valp);
+        if (val < 0) {
+            fl->v3fatal("--preproc-jobs requires a non-negative integer, but '"
+                        << valp << "' was passed");
+            val = 1;
+        } else if (val == 0) {
+            val = std::thread::hardware_concurrency();
+        }
+        m_preprocJobs = val;
+    });
     DECL_OPTION("-private", CbCall, [this]() { m_public = false; });
     DECL_OPTION("-prof-c", OnOff, &m_profC);
     DECL_OPTION("-prof-cfuncs", CbCall, [this]() { m_profC = m_profCFuncs = true; });
@@ -1378,6 +1526,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
         m_outFormatOk = true;
         m_systemC = true;
     });
+    DECL_OPTION("-scc-iterate", OnOff, &m_sccIterate);
     DECL_OPTION("-skip-identical", OnOff, &m_skipIdentical);
     DECL_OPTION("-stats", OnOff, &m_stats);
     DECL_OPTION("-stats-vars", CbOnOff, [this](bool flag) {
@@ -1583,6 +1732,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
     });
 
     DECL_OPTION("-sym-exec-main", OnOff, &m_symExecMain);
+    DECL_OPTION("-smt2", OnOff, &m_smt2);
 
     DECL_OPTION("-y", CbVal, [this, &optdir](const char* valp) {
         addIncDirUser(parseFileArg(optdir, string(valp)));
@@ -1604,6 +1754,10 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
         } else if (argv[i][0] == '-' || argv[i][0] == '+') {
             const char* argvNoDashp = (argv[i][1] == '-') ? (argv[i] + 2) : (argv[i] + 1);
             if (const int consumed = parser.parse(i, argc, argv)) {
+                if (!isBackendOption(argv[i])) {
+                    m_impp->m_frontendArgs.insert(m_impp->m_frontendArgs.end(), argv + i,
+                                                  argv + i + consumed);
+                }
                 i += consumed;
             } else if (isFuture0(argvNoDashp)) {
                 ++i;
@@ -1628,6 +1782,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
                 V3Options::addLdLibs(filename);
             } else {
                 V3Options::addVFile(filename);
+                m_impp->m_frontendArgs.push_back(filename);
             }
             ++i;
         }
@@ -1780,6 +1935,65 @@ void V3Options::parseOptsFile(FileLine* fl, const string& filename, bool rel) {
 
 //======================================================================
 
+void V3Options::parseForkConfig(FileLine* fl, const string& filename) {
+    // Called after the frontend, so options that affect parsing or elaboration
+    // can no longer take effect; refuse the ones we can detect.
+    const size_t vFiles = m_vFiles.size();
+    const size_t libraryFiles = m_libraryFiles.size();
+    const size_t parameters = m_parameters.size();
+    const string topModule = m_topModule;
+    const string prefix = m_prefix;
+    const string makeDir = m_makeDir;
+    // Default subdirectory, numbered by position if another configuration
+    // file has the same name, e.g. a/x.vc and b/x.vc
+    string subDir = V3Os::filenameNonDirExt(filename);
+    int sameName = 0;
+    int position = 0;
+    for (const string& config : m_forkConfigs) {
+        if (V3Os::filenameNonDirExt(config) != subDir) continue;
+        ++sameName;
+        if (config == filename) position = sameName;
+    }
+    if (sameName > 1) subDir += "__" + cvtToStr(position);
+    m_forkConfigs.clear();
+
+    parseOptsFile(fl, filename, false);
+
+    if (m_vFiles.size() != vFiles || m_libraryFiles.size() != libraryFiles
+        || m_parameters.size() != parameters || m_topModule != topModule || m_prefix != prefix) {
+        fl->v3error("--fork-config file may not change input files, parameters, "
+                    "--top-module or --prefix: "
+                    << filename);
+    }
+    if (!m_forkConfigs.empty()) {
+        fl->v3error("--fork-config file may not contain --fork-config: " << filename);
+    }
+    if (lintOnly() || xmlOnly() || preprocOnly() || dpiHdrOnly() || cdc() || hierarchical()) {
+        fl->v3error("--fork-config file may not change the output mode: " << filename);
+    }
+    // Default each configuration into its own subdirectory
+    if (m_makeDir == makeDir) {
+        m_makeDir = makeDir + "/" + subDir;
+        addIncDirFallback(m_makeDir);
+    }
+    // Options from the file need the same final adjustments as the command line
+    notify();
+}
+
+void V3Options::restartOpts(FileLine* fl, const std::vector<string>& args) {
+    // The executable path is not on the command line; keep it
+    const string buildDepBin = m_buildDepBin;
+    *this = V3Options{};
+    m_buildDepBin = buildDepBin;
+    std::vector<char*> argv;
+    for (const string& arg : args) argv.push_back(const_cast<char*>(arg.c_str()));
+    argv.push_back(nullptr);
+    parseOpts(fl, static_cast<int>(args.size()), argv.data());
+    notify();
+}
+
+//======================================================================
+
 string V3Options::parseFileArg(const string& optdir, const string& relfilename) {
     string filename = V3Os::filenameSubstitute(relfilename);
     if (optdir != "." && V3Os::filenameIsRel(filename)) filename = optdir + "/" + filename;
@@ -1834,9 +2048,8 @@ void V3Options::showVersion(bool verbose) {
 
 //======================================================================
 
-V3Options::V3Options() {
-    m_impp = new V3OptionsImp;
-
+V3Options::V3Options()
+    : m_impp{new V3OptionsImp} {
     m_traceFormat = TraceFormat::VCD;
 
     m_makeDir = "obj_dir";
@@ -1856,7 +2069,9 @@ V3Options::V3Options() {
     addIncDirFallback(".");  // Looks better than {long_cwd_path}/...
 }
 
-V3Options::~V3Options() { VL_DO_CLEAR(delete m_impp, m_impp = nullptr); }
+V3Options::~V3Options() = default;
+
+V3Options& V3Options::operator=(V3Options&&) = default;
 
 void V3Options::setDebugMode(int level) {
     V3Error::debugDefault(level);
@@ -24,6 +24,7 @@
 #include "V3LangCode.h"
 
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -195,7 +196,7 @@ private:
     using DebugLevelMap = std::map<const std::string, unsigned>;
 
     // MEMBERS (general options)
-    V3OptionsImp* m_impp;  // Slow hidden options
+    std::unique_ptr<V3OptionsImp> m_impp;  // Slow hidden options
 
     // clang-format off
     V3StringSet m_cppFiles;     // argument: C++ files to link against
@@ -210,6 +211,7 @@ private:
     V3StringSet m_noClockers;   // argument: Verilog -noclk signals
     V3StringList m_vFiles;      // argument: Verilog files to read
     V3StringList m_forceIncs;   // argument: -FI
+    V3StringList m_forkConfigs; // argument: --fork-config option files
     DebugLevelMap m_debugLevel; // argument: --debugi-<srcfile/tag> <level>
     DebugLevelMap m_dumpLevel;  // argument: --dumpi-<srcfile/tag> <level>
     std::map<const string, string> m_parameters;  // Parameters
@@ -246,11 +248,13 @@ private:
     bool m_exe = false;             // main switch: --exe
     bool m_flatten = false;         // main switch: --flatten
     bool m_hierarchical = false;    // main switch: --hierarchical
+    bool m_hierFork = false;        // main switch: --hierarchical-fork
     bool m_ignc = false;            // main switch: --ignc
     bool m_lintOnly = false;        // main switch: --lint-only
     bool m_gmake = false;           // main switch: --make gmake
     bool m_main = false;            // main swithc: --main
     bool m_outFormatOk = false;     // main switch: --cc, --sc or --sp was specified
+    bool m_pch = false;             // main switch: --pch
     bool m_pedantic = false;        // main switch: --Wpedantic
     bool m_pinsScUint = false;      // main switch: --pins-sc-uint
     bool m_pinsScBigUint = false;   // main switch: --pins-sc-biguint
@@ -267,6 +271,7 @@ private:
     bool m_relativeIncludes = false; // main switch: --relative-includes
     bool m_reportUnoptflat = false; // main switch: --report-unoptflat
     bool m_savable = false;         // main switch: --savable
+    bool m_sccIterate = false;      // main switch: --scc-iterate
     bool m_structsPacked = true;    // main switch: --structs-packed
     bool m_systemC = false;         // main switch: --sc: System C instead of simple C++
     bool m_stats = false;           // main switch: --stats
@@ -286,8 +291,10 @@ private:
     bool m_xInitialEdge = false;    // main switch: --x-initial-edge
     bool m_xmlOnly = false;         // main switch: --xml-only
     bool m_symExecMain = false;     // main switch: --sym-exec-main
+    bool m_smt2 = false;            // main switch: --smt2
 
     int         m_buildJobs = -1;    // main switch: --build-jobs, -j
+    int         m_preprocJobs = 1;   // main switch: --preproc-jobs
     int         m_convergeLimit = 100;  // main switch: --converge-limit
     int         m_coverageMaxWidth = 256; // main switch: --coverage-max-width
     int         m_expandLimit = 64;  // main switch: --expand-limit
@@ -324,14 +331,18 @@ private:
     int         m_compLimitParens = 240;  // compiler selection; number of nested parens
 
     string      m_buildDepBin;  // main switch: --build-dep-bin {filename}
+    string      m_checkpointDir;  // main switch: --checkpoint-dir {dirname}
+    string      m_evalPatterns;  // main switch: --eval-patterns {filename}
     string      m_exeName;      // main switch: -o {name}
     string      m_flags;        // main switch: -f {name}
     string      m_l2Name;       // main switch: --l2name; "" for top-module's name
     string      m_libCreate;    // main switch: --lib-create {lib_name}
     string      m_makeDir;      // main switch: -Mdir
     string      m_modPrefix;    // main switch: --mod-prefix
+    string      m_outputArchive;  // main switch: --output-archive {filename}
     string      m_pipeFilter;   // main switch: --pipe-filter
     string      m_prefix;       // main switch: --prefix
+    string      m_preprocCacheDir;  // main switch: --preproc-cache-dir {dirname}
     string      m_protectKey;   // main switch: --protect-key
     string      m_topModule;    // main switch: --top-module
     string      m_unusedRegexp; // main switch: --unused-regexp
@@ -365,12 +376,19 @@ private:
     bool m_fMergeCond;   // main switch: -fno-merge-cond: merge conditionals
     bool m_fMergeCondMotion = true; // main switch: -fno-merge-cond-motion: perform code motion
     bool m_fMergeConstPool = true;  // main switch: -fno-merge-const-pool
+    bool m_fNbaQueue = true;  // main switch: -fno-nba-queue: commit queues for delayed arrays
     bool m_fReloop;      // main switch: -fno-reloop: reform loops
     bool m_fReorder;     // main switch: -fno-reorder: reorder assignments in blocks
     bool m_fSplit;       // main switch: -fno-split: always assignment splitting
     bool m_fSubst;       // main switch: -fno-subst: substitute expression temp values
     bool m_fSubstConst;  // main switch: -fno-subst-const: final constant substitution
     bool m_fTable;       // main switch: -fno-table: lookup table creation
+    bool m_fTraceVector = true;  // main switch: -fno-trace-vector: block compare traced arrays
+    // Given on the command line, so not changed by the --sym-exec-main defaults
+    bool m_expandLimitSet = false;  // --expand-limit
+    bool m_fMergeCondSet = false;   // -f[no-]merge-cond or -O[wW]
+    bool m_fReloopSet = false;      // -f[no-]reloop or -O[vV]
+    bool m_fTableSet = false;       // -f[no-]table or -O[aA]
     // clang-format on
 
     bool m_available = false;  // Set to true at the end of option parsing
@@ -401,6 +419,7 @@ private:
 public:
     V3Options();
     ~V3Options();
+    V3Options& operator=(V3Options&&);
     void setDebugMode(int level);
     unsigned debugLevel(const string& tag) const VL_MT_SAFE;
     unsigned debugSrcLevel(const string& srcfile_path) const VL_MT_SAFE;
@@ -440,6 +459,7 @@ public:
     string buildDepBin() const { return m_buildDepBin; }
     void buildDepBin(const string& flag) { m_buildDepBin = flag; }
     bool cdc() const { return m_cdc; }
+    string checkpointDir() const { return m_checkpointDir; }
     bool cmake() const { return m_cmake; }
     bool context() const VL_MT_SAFE { return m_context; }
     bool coverage() const VL_MT_SAFE {
@@ -480,6 +500,7 @@ public:
     bool main() const { return m_main; }
     bool outFormatOk() const { return m_outFormatOk; }
     bool keepTempFiles() const { return (V3Error::debugDefault() != 0); }
+    bool pch() const { return m_pch; }
     bool pedantic() const { return m_pedantic; }
     bool pinsScUint() const { return m_pinsScUint; }
     bool pinsScBigUint() const { return m_pinsScBigUint; }
@@ -497,11 +518,13 @@ public:
     bool ignc() const { return m_ignc; }
     bool quietExit() const VL_MT_SAFE { return m_quietExit; }
     bool reportUnoptflat() const { return m_reportUnoptflat; }
+    bool sccIterate() const { return m_sccIterate; }
     bool verilate() const { return m_verilate; }
     bool vpi() const { return m_vpi; }
     bool xInitialEdge() const { return m_xInitialEdge; }
     bool xmlOnly() const { return m_xmlOnly; }
     bool symExecMain() const { return m_symExecMain; }
+    bool smt2() const { return m_smt2; }
     bool topIfacesSupported() const { return lintOnly() && !hierarchical(); }
 
     int buildJobs() const VL_MT_SAFE { return m_buildJobs; }
@@ -517,8 +540,13 @@ public:
     int maxNumWidth() const { return m_maxNumWidth; }
     int moduleRecursionDepth() const { return m_moduleRecursion; }
     int outputSplit() const { return m_outputSplit; }
-    int outputSplitCFuncs() const { return m_outputSplitCFuncs; }
-    int outputSplitCTrace() const { return m_outputSplitCTrace; }
+    // Split limits default to --output-split; resolved late so --fork-config may change it
+    int outputSplitCFuncs() const {
+        return m_outputSplitCFuncs < 0 ? m_outputSplit : m_outputSplitCFuncs;
+    }
+    int outputSplitCTrace() const {
+        return m_outputSplitCTrace < 0 ? m_outputSplit : m_outputSplitCTrace;
+    }
     int pinsBv() const { return m_pinsBv; }
     int reloopLimit() const { return m_reloopLimit; }
     VOptionBool skipIdentical() const { return m_skipIdentical; }
@@ -551,6 +579,7 @@ public:
     int compLimitMembers() const { return m_compLimitMembers; }
     int compLimitParens() const { return m_compLimitParens; }
 
+    string evalPatterns() const { return m_evalPatterns; }
     string exeName() const { return m_exeName != "" ? m_exeName : prefix(); }
     string l2Name() const { return m_l2Name; }
     string libCreate() const { return m_libCreate; }
@@ -565,8 +594,11 @@ public:
     }
     string makeDir() const VL_MT_SAFE { return m_makeDir; }
     string modPrefix() const VL_MT_SAFE { return m_modPrefix; }
+    string outputArchive() const { return m_outputArchive; }
     string pipeFilter() const { return m_pipeFilter; }
     string prefix() const VL_MT_SAFE { return m_prefix; }
+    string preprocCacheDir() const { return m_preprocCacheDir; }
+    int preprocJobs() const { return m_preprocJobs; }
     // Not just called protectKey() to avoid bugs of not using protectKeyDefaulted()
     bool protectKeyProvided() const { return !m_protectKey.empty(); }
     string protectKeyDefaulted();  // Set default key if not set by user
@@ -585,6 +617,7 @@ public:
     const V3StringSet& libraryFiles() const { return m_libraryFiles; }
     const V3StringList& vFiles() const { return m_vFiles; }
     const V3StringList& forceIncs() const { return m_forceIncs; }
+    const V3StringList& forkConfigs() const { return m_forkConfigs; }
 
     bool hasParameter(const string& name);
     string parameter(const string& name);
@@ -621,12 +654,14 @@ public:
     bool fMergeCond() const { return m_fMergeCond; }
     bool fMergeCondMotion() const { return m_fMergeCondMotion; }
     bool fMergeConstPool() const { return m_fMergeConstPool; }
+    bool fNbaQueue() const { return m_fNbaQueue; }
     bool fReloop() const { return m_fReloop; }
     bool fReorder() const { return m_fReorder; }
     bool fSplit() const { return m_fSplit; }
     bool fSubst() const { return m_fSubst; }
     bool fSubstConst() const { return m_fSubstConst; }
     bool fTable() const { return m_fTable; }
+    bool fTraceVector() const { return m_fTraceVector; }
 
     string traceClassBase() const { return m_traceFormat.classBase(); }
     string traceClassLang() const { return m_traceFormat.classBase() + (systemC() ? "Sc" : "C"); }
@@ -636,6 +671,7 @@ public:
     }
 
     bool hierarchical() const { return m_hierarchical; }
+    bool hierFork() const { return m_hierFork; }
     int hierChild() const { return m_hierChild; }
     bool hierTop() const VL_MT_SAFE { return !m_hierChild && !m_hierBlocks.empty(); }
     const V3HierBlockOptSet& hierBlocks() const { return m_hierBlocks; }
@@ -648,6 +684,14 @@ public:
     // METHODS (from main)
     static string version();
     static string argString(int argc, char** argv);  ///< Return list of arguments as simple string
+    // Arguments as given to parseOpts(), and as a simple string matching argString()
+    const std::vector<string>& commandArgs() const VL_MT_SAFE;
+    string commandArgString() const;
+    // Arguments that may change the netlist up to elaboration, see --checkpoint-dir
+    const std::vector<string>& frontendArgs() const;
+    // Files looked for with fileExists(), and if found, see --checkpoint-dir
+    const std::map<const string, bool>& fileProbes() const;
+    void fileProbed(const string& filename, bool found);
     string allArgsString() const VL_MT_SAFE;  ///< Return all passed arguments as simple string
     // Return options for child hierarchical blocks when forTop==false, otherwise returns args for
     // the top module.
@@ -655,6 +699,10 @@ public:
     void parseOpts(FileLine* fl, int argc, char** argv);
     void parseOptsList(FileLine* fl, const string& optdir, int argc, char** argv);
     void parseOptsFile(FileLine* fl, const string& filename, bool rel);
+    // Apply a --fork-config file in a forked backend process
+    void parseForkConfig(FileLine* fl, const string& filename);
+    // Start over from the defaults with another command line
+    void restartOpts(FileLine* fl, const std::vector<string>& args);
 
     // METHODS (environment)
     // Most of these may be built into the executable with --enable-defenv,
@@ -75,6 +75,8 @@ VL_DEFINE_DEBUG_FUNCTIONS;
 //######################################################################
 // Environment
 
+std::map<string, string> V3Os::s_getenvReads;
+
 string V3Os::getenvStr(const string& envvar, const string& defaultValue) {
 #if defined(_MSC_VER)
     // Note: MinGW does not offer _dupenv_s
@@ -83,14 +85,18 @@ string V3Os::getenvStr(const string& envvar, const string& defaultValue) {
     if (envvalue != nullptr) {
         const std::string result{envvalue};
         free(envvalue);
+        s_getenvReads[envvar] = result;
         return result;
     } else {
+        s_getenvReads[envvar] = "";
         return defaultValue;
     }
 #else
     if (const char* const envvalue = getenv(envvar.c_str())) {
+        s_getenvReads[envvar] = envvalue;
         return envvalue;
     } else {
+        s_getenvReads[envvar] = "";
         return defaultValue;
     }
 #endif
@@ -335,6 +341,27 @@ uint64_t V3Os::memUsageBytes() {
 #endif
 }
 
+uint64_t V3Os::memPeakUsageBytes() {
+#if defined(_WIN32) || defined(__MINGW32__)
+    const HANDLE process = GetCurrentProcess();
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(process, &pmc, sizeof(pmc))) return pmc.PeakWorkingSetSize;
+    return 0;
+#else
+    // Highly unportable. Sorry
+    const char* const statusFilename = "/proc/self/status";
+    FILE* fp = fopen(statusFilename, "r");
+    if (!fp) return 0;
+    uint64_t peakKb = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), fp)) {
+        if (1 == sscanf(line, "VmHWM: %" SCNu64, &peakKb)) break;
+    }
+    fclose(fp);
+    return peakKb * 1024;
+#endif
+}
+
 void V3Os::u_sleep(int64_t usec) {
 #if defined(_WIN32) || defined(__MINGW32__)
     std::this_thread::sleep_for(std::chrono::microseconds(usec));
@@ -363,3 +390,39 @@ int V3Os::system(const string& command) {
         return exit_code;
     }
 }
+
+int V3Os::forkProcess() {
+#if defined(_WIN32) || defined(__MINGW32__)
+    v3fatal("Unsupported: fork() is not available on this platform");
+    return -1;  // LCOV_EXCL_LINE
+#else
+    // Flush so buffered output is not duplicated into the child
+    std::cout.flush();
+    std::cerr.flush();
+    const pid_t pid = ::fork();
+    if (VL_UNCOVERABLE(pid < 0)) {
+        v3fatal("Failed to fork: " << std::strerror(errno));  // LCOV_EXCL_LINE
+    }
+    UINFO(1, "Forked process " << pid << endl);
+    return pid;
+#endif
+}
+
+int V3Os::waitProcess(int pid) {
+#if defined(_WIN32) || defined(__MINGW32__)
+    v3fatal("Unsupported: fork() is not available on this platform");
+    return -1;  // LCOV_EXCL_LINE
+#else
+    int status = 0;
+    while (::waitpid(pid, &status, 0) < 0) {
+        if (VL_UNCOVERABLE(errno != EINTR)) {
+            v3fatal("Failed to wait for process " << pid << ": "  // LCOV_EXCL_LINE
+                                                  << std::strerror(errno));
+        }
+    }
+    // Report a signal death as the shell would
+    const int exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+    UINFO(1, "Process " << pid << " returned exit code of " << exit_code << std::endl);
+    return exit_code;
+#endif
+}
@@ -21,6 +21,7 @@
 #include "verilatedos.h"
 
 #include <array>
+#include <map>
 
 // Limited V3 headers here - this is a base class for Vlc etc
 #include "V3Error.h"
@@ -29,9 +30,13 @@
 // V3Os: OS static class
 
 class V3Os final {
+    static std::map<string, string> s_getenvReads;  // Variables read by getenvStr
+
 public:
     // METHODS (environment)
     static string getenvStr(const string& envvar, const string& defaultValue);
+    // Variables read by getenvStr so far, and their values (empty if unset)
+    static const std::map<string, string>& getenvReads() { return s_getenvReads; }
     static void setenvStr(const string& envvar, const string& value, const string& why);
 
     // METHODS (generic filename utilities)
@@ -65,10 +70,16 @@ public:
     /// Return wall time since epoch in microseconds, or 0 if not implemented
     static uint64_t timeUsecs();
     static uint64_t memUsageBytes();  ///< Return memory usage in bytes, or 0 if not implemented
+    /// Return peak resident memory in bytes, or 0 if not implemented
+    static uint64_t memPeakUsageBytes();
 
     // METHODS (sub command)
     /// Run system command, returns the exit code of the child process.
     static int system(const string& command);
+    /// Fork the current process, returns 0 in the child and the child's pid in the parent.
+    static int forkProcess();
+    /// Wait for a process created by forkProcess(), returns its exit code.
+    static int waitProcess(int pid);
 };
 
 #endif  // Guard
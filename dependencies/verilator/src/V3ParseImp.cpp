@@ -36,6 +36,7 @@
 #include "V3ParseBison.h"  // Generated by bison
 #include "V3PreShell.h"
 
+#include <algorithm>
 #include <sstream>
 
 VL_DEFINE_DEBUG_FUNCTIONS;
@@ -227,16 +228,15 @@ size_t V3ParseImp::ppInputToLex(char* buf, size_t max_size) {
     size_t got = 0;
     while (got < max_size  // Haven't got enough
            && !m_ppBuffers.empty()) {  // And something buffered
-        string front = m_ppBuffers.front();
-        m_ppBuffers.pop_front();
-        size_t len = front.length();
-        if (len > (max_size - got)) {  // Front string too big
-            const string remainder = front.substr(max_size - got);
-            front = front.substr(0, max_size - got);
-            m_ppBuffers.push_front(remainder);  // Put back remainder for next time
-            len = (max_size - got);
+        // Leave any remainder in place, rather than copying it, for next time
+        const string& front = m_ppBuffers.front();
+        const size_t len = std::min(front.length() - m_ppFrontOffset, max_size - got);
+        std::memcpy(buf + got, front.data() + m_ppFrontOffset, len);
+        m_ppFrontOffset += len;
+        if (m_ppFrontOffset == front.length()) {
+            m_ppBuffers.pop_front();
+            m_ppFrontOffset = 0;
         }
-        std::memcpy(buf + got, front.c_str(), len);
         got += len;
     }
     if (debug() >= 9) {
@@ -317,6 +317,7 @@ void V3ParseImp::parseFile(FileLine* fileline, const string& modfilename, bool i
         lexFile(modfilename);
     } else {
         m_ppBuffers.clear();
+        m_ppFrontOffset = 0;
     }
 }
 
@@ -3176,21 +3176,25 @@ static void addThreadStartToExecGraph(AstExecGraph* const execGraphp,
                + ";\n");
 
     const uint32_t last = funcps.size() - 1;
-    for (uint32_t i = 0; i <= last; ++i) {
-        AstCFunc* const funcp = funcps.at(i);
-        if (i != last) {
-            // The first N-1 will run on the thread pool.
-            addTextStmt("vlSymsp->__Vm_threadPoolp->workerp(" + cvtToStr(i) + ")->addTask(");
-            execGraphp->addStmtsp(new AstAddrOfCFunc(fl, funcp));
-            addTextStmt(", vlSelf, vlSymsp->__Vm_even_cycle__" + tag + ");\n");
-        } else {
-            // The last will run on the main thread.
-            AstCCall* const callp = new AstCCall(fl, funcp);
-            callp->argTypes("vlSelf, vlSymsp->__Vm_even_cycle__" + tag);
-            execGraphp->addStmtsp(callp);
-            addStrStmt("Verilated::mtaskId(0);\n");
-        }
-    }
+    if (last > 0) {
+        // The first N-1 will run on the thread pool, dispatched together so evaluations of
+        // other models sharing the pool interleave with this one in a consistent order.
+        const string arrayName = "__Vm_threadFuncps__" + tag;
+        addTextStmt("static const VlExecFnp " + arrayName + "[] = {");
+        for (uint32_t i = 0; i < last; ++i) {
+            if (i) addTextStmt(", ");
+            execGraphp->addStmtsp(new AstAddrOfCFunc(fl, funcps.at(i)));
+        }
+        addTextStmt("};\n");
+        addTextStmt("vlSymsp->__Vm_threadPoolp->dispatch(" + arrayName + ", " + cvtToStr(last)
+                    + ", vlSelf, vlSymsp->__Vm_even_cycle__" + tag
+                    + ", vlSymsp->_vm_contextp__);\n");
+    }
+    // The last will run on the main thread.
+    AstCCall* const callp = new AstCCall(fl, funcps.at(last));
+    callp->argTypes("vlSelf, vlSymsp->__Vm_even_cycle__" + tag);
+    execGraphp->addStmtsp(callp);
+    addStrStmt("Verilated::mtaskId(0);\n");
 
     addStrStmt("vlSelf->__Vm_mtaskstate_final__" + tag
                + ".waitUntilUpstreamDone(vlSymsp->__Vm_even_cycle__" + tag + ");\n");
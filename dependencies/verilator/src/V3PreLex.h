@@ -22,6 +22,7 @@
 #define VERILATOR_VPRELEX_H_
 
 #include "V3Error.h"
+#include "V3File.h"
 #include "V3FileLine.h"
 
 #include <deque>
@@ -130,7 +131,7 @@ class VPreStream final {
 public:
     FileLine* m_curFilelinep;  // Current processing point (see also m_tokFilelinep)
     V3PreLex* const m_lexp;  // Lexer, for resource tracking
-    std::deque<string> m_buffers;  // Buffer of characters to process
+    std::deque<VInBuffer> m_buffers;  // Buffer of characters to process
     int m_ignNewlines = 0;  // Ignore multiline newlines
     bool m_eof = false;  // "EOF" buffer
     bool m_file = false;  // Buffer is start of new file
@@ -213,7 +214,7 @@ public:  // Used only by V3PreLex.cpp and V3PreProc.cpp
     void pushStateIncFilename();
     void scanNewFile(FileLine* filelinep);
     void scanBytes(const string& str);
-    void scanBytesBack(const string& str);
+    void scanBytesBack(VInBuffer buffer);
     size_t inputToLex(char* buf, size_t max_size);
     /// Called by V3PreProc.cpp to get data from lexer
     YY_BUFFER_STATE currentBuffer();
@@ -30,6 +30,7 @@
 #include <algorithm>
 #include <cstdlib>
 #include <fstream>
+#include <set>
 #include <stack>
 #include <vector>
 
@@ -112,11 +113,16 @@ class V3PreProcImp final : public V3PreProc {
 public:
     // TYPES
     using DefinesMap = std::map<const std::string, VDefine>;
-    using StrList = VInFilter::StrList;
 
     // Defines list
     DefinesMap m_defines;  ///< Map of defines
 
+    // Defines tracking, see definesTrackStart()
+    bool m_tracking = false;  // Recording defines read and changed
+    V3PreProcDefinesUse m_use;  // Defines read and changed, while m_tracking
+    std::set<string> m_trackedReads;  // Names read, while m_tracking
+    std::set<string> m_trackedWrites;  // Names changed, while m_tracking
+
     // STATE
     const V3PreProc* m_preprocp = nullptr;  ///< Object we're holding data for
     V3PreLex* m_lexp = nullptr;  ///< Current lexer state (nullptr = closed)
@@ -196,6 +202,13 @@ private:
     void endOfOneFile();
     string defineSubst(VDefineRef* refp);
 
+    void trackRead(const string& name);
+    void trackWrite(const string& name) {
+        if (m_tracking) m_trackedWrites.insert(name);
+    }
+    bool defMatches(const V3PreProcDefine& saved) const;
+    void defRestore(DefinesMap& defines, const V3PreProcDefine& saved);
+
     bool defExists(const string& name);
     string defValue(const string& name);
     string defParams(const string& name);
@@ -253,6 +266,12 @@ public:
     void comment(const string& text) override;  // Comment detected (if keepComments==2)
     void include(const string& filename) override;  // Request a include file be processed
     void undef(const string& name) override;
+    std::vector<V3PreProcDefine> definesSave() const override;
+    void definesRestore(const std::vector<V3PreProcDefine>& defines) override;
+    void definesTrackStart() override;
+    V3PreProcDefinesUse definesTrackStop() override;
+    bool definesMatch(const V3PreProcDefinesUse& use) const override;
+    void definesApply(const V3PreProcDefinesUse& use) override;
     virtual void undefineall();
     void define(FileLine* fl, const string& name, const string& value, const string& params,
                 bool cmdline) override;
@@ -288,19 +307,113 @@ V3PreProc* V3PreProc::createPreProc(FileLine* fl) {
 //*************************************************************************
 // Defines
 
-void V3PreProcImp::undef(const string& name) { m_defines.erase(name); }
+void V3PreProcImp::undef(const string& name) {
+    trackWrite(name);
+    m_defines.erase(name);
+}
 void V3PreProcImp::undefineall() {
+    if (m_tracking) m_use.m_all = true;
     for (DefinesMap::iterator nextit, it = m_defines.begin(); it != m_defines.end(); it = nextit) {
         nextit = it;
         ++nextit;
         if (!it->second.cmdline()) m_defines.erase(it);
     }
 }
+std::vector<V3PreProcDefine> V3PreProcImp::definesSave() const {
+    std::vector<V3PreProcDefine> defines;
+    defines.reserve(m_defines.size());
+    for (const auto& itr : m_defines) {
+        const VDefine& def = itr.second;
+        defines.push_back({itr.first, def.value(), def.params(), def.cmdline(),
+                           def.fileline()->filename(), def.fileline()->lineno()});
+    }
+    return defines;
+}
+bool V3PreProcImp::defMatches(const V3PreProcDefine& saved) const {
+    const auto it = m_defines.find(saved.m_name);
+    return it != m_defines.end() && it->second.value() == saved.m_value
+           && it->second.params() == saved.m_params && it->second.cmdline() == saved.m_cmdline;
+}
+void V3PreProcImp::defRestore(DefinesMap& defines, const V3PreProcDefine& saved) {
+    if (defMatches(saved)) {
+        // Unchanged, keep declaration point
+        defines.emplace(saved.m_name, m_defines.find(saved.m_name)->second);
+    } else {
+        FileLine* const fl = new FileLine{saved.m_filename};
+        fl->lineno(saved.m_lineno);
+        defines.emplace(saved.m_name, VDefine{fl, saved.m_value, saved.m_params, saved.m_cmdline});
+    }
+}
+void V3PreProcImp::definesRestore(const std::vector<V3PreProcDefine>& defines) {
+    if (m_tracking) m_use.m_all = true;  // E.g. from --preproc-cache-dir
+    DefinesMap restored;
+    for (const V3PreProcDefine& saved : defines) defRestore(restored, saved);
+    m_defines.swap(restored);
+}
+void V3PreProcImp::trackRead(const string& name) {
+    // Only the first read before any change depends on the defines before
+    if (!m_tracking || m_trackedWrites.count(name) || !m_trackedReads.insert(name).second) {
+        return;
+    }
+    const auto it = m_defines.find(name);
+    if (it == m_defines.end()) {
+        m_use.m_readUndefined.push_back(name);
+    } else {
+        const VDefine& def = it->second;
+        m_use.m_readDefined.push_back({name, def.value(), def.params(), def.cmdline(),
+                                       def.fileline()->filename(), def.fileline()->lineno()});
+    }
+}
+void V3PreProcImp::definesTrackStart() {
+    m_tracking = true;
+    m_use = V3PreProcDefinesUse{};
+    m_trackedReads.clear();
+    m_trackedWrites.clear();
+}
+V3PreProcDefinesUse V3PreProcImp::definesTrackStop() {
+    for (const string& name : m_trackedWrites) {
+        const auto it = m_defines.find(name);
+        if (it == m_defines.end()) {
+            m_use.m_wroteUndefined.push_back(name);
+        } else {
+            const VDefine& def = it->second;
+            m_use.m_wroteDefined.push_back({name, def.value(), def.params(), def.cmdline(),
+                                            def.fileline()->filename(),
+                                            def.fileline()->lineno()});
+        }
+    }
+    m_tracking = false;
+    m_trackedReads.clear();
+    m_trackedWrites.clear();
+    return std::move(m_use);
+}
+bool V3PreProcImp::definesMatch(const V3PreProcDefinesUse& use) const {
+    if (use.m_all) return false;
+    for (const V3PreProcDefine& saved : use.m_readDefined) {
+        if (!defMatches(saved)) return false;
+    }
+    for (const string& name : use.m_readUndefined) {
+        if (m_defines.count(name)) return false;
+    }
+    return true;
+}
+void V3PreProcImp::definesApply(const V3PreProcDefinesUse& use) {
+    UASSERT(!use.m_all, "Changes to all defines are not recorded");
+    for (const string& name : use.m_wroteUndefined) m_defines.erase(name);
+    for (const V3PreProcDefine& saved : use.m_wroteDefined) {
+        DefinesMap changed;
+        defRestore(changed, saved);
+        m_defines.erase(saved.m_name);
+        m_defines.insert(*changed.begin());
+    }
+}
 bool V3PreProcImp::defExists(const string& name) {
+    trackRead(name);
     const auto iter = m_defines.find(name);
     return (iter != m_defines.end());
 }
 string V3PreProcImp::defValue(const string& name) {
+    trackRead(name);
     const auto iter = m_defines.find(name);
     if (iter == m_defines.end()) {
         fileline()->v3error("Define or directive not defined: `" + name);
@@ -309,6 +422,7 @@ string V3PreProcImp::defValue(const string& name) {
     return iter->second.value();
 }
 string V3PreProcImp::defParams(const string& name) {
+    trackRead(name);
     const auto iter = m_defines.find(name);
     if (iter == m_defines.end()) {
         fileline()->v3error("Define or directive not defined: `" + name);
@@ -317,6 +431,7 @@ string V3PreProcImp::defParams(const string& name) {
     return iter->second.params();
 }
 FileLine* V3PreProcImp::defFileline(const string& name) {
+    trackRead(name);
     const auto iter = m_defines.find(name);
     if (iter == m_defines.end()) return nullptr;
     return iter->second.fileline();
@@ -344,6 +459,7 @@ void V3PreProcImp::define(FileLine* fl, const string& name, const string& value,
             }
             undef(name);
         }
+        trackWrite(name);
         m_defines.emplace(name, VDefine(fl, value, params, cmdline));
     }
 }
@@ -770,8 +886,8 @@ void V3PreProcImp::openFile(FileLine*, VInFilter* filterp, const string& filenam
     m_lexp->setYYDebug(debug() >= 5);
     V3File::addSrcDepend(filename);
 
-    // Read a list<string> with the whole file.
-    StrList wholefile;
+    // Read the whole file; large files are memory mapped, not copied
+    VInBuffer wholefile;
     const bool ok = filterp->readWholefile(filename, wholefile /*ref*/);
     if (!ok) {
         error("File not found: " + filename + "\n");
@@ -796,7 +912,11 @@ void V3PreProcImp::openFile(FileLine*, VInFilter* filterp, const string& filenam
     FileLine* const flsp = new FileLine(filename);
     flsp->lineno(1);
     flsp->newContent();
-    for (const string& i : wholefile) flsp->contentp()->pushText(i);
+    if (wholefile.mapped()) {
+        flsp->contentp()->pushMapped(wholefile.mapping(), wholefile.size());
+    } else {
+        flsp->contentp()->pushText(wholefile.data(), wholefile.size());
+    }
 
     // Create new stream structure
     m_lexp->scanNewFile(flsp);
@@ -807,11 +927,11 @@ void V3PreProcImp::openFile(FileLine*, VInFilter* filterp, const string& filenam
     // to be multi-line without a "\"
     int eof_newline = 0;  // Number of characters following last newline
     int eof_lineno = 1;
-    for (StrList::iterator it = wholefile.begin(); it != wholefile.end(); ++it) {
+    {
         // We don't end-loop at \0 as we allow and strip mid-string '\0's (for now).
         bool strip = false;
-        const char* const sp = it->data();
-        const char* const ep = sp + it->length();
+        const char* const sp = wholefile.data();
+        const char* const ep = sp + wholefile.size();
         // Only process if needed, as saves extra string allocations
         for (const char* cp = sp; cp < ep; cp++) {
             if (VL_UNLIKELY(*cp == '\r' || *cp == '\0')) {
@@ -825,17 +945,16 @@ void V3PreProcImp::openFile(FileLine*, VInFilter* filterp, const string& filenam
         }
         if (strip) {
             string out;
-            out.reserve(it->length());
+            out.reserve(wholefile.size());
             for (const char* cp = sp; cp < ep; cp++) {
                 if (!(*cp == '\r' || *cp == '\0')) out += *cp;
             }
-            *it = out;
+            wholefile = VInBuffer{std::move(out)};
         }
 
-        // Push the data to an internal buffer.
-        m_lexp->scanBytesBack(*it);
-        // Reclaim memory; the push saved the string contents for us
-        *it = "";
+        // Push the data to an internal buffer; the lexer reads directly
+        // from the mapping when the file was mapped and needed no stripping
+        m_lexp->scanBytesBack(std::move(wholefile));
     }
 
     // Warning check
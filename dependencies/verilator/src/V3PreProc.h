@@ -27,6 +27,7 @@
 #include <iostream>
 #include <list>
 #include <map>
+#include <vector>
 
 // Compatibility with Verilog-Perl's preprocessor
 #define fatalSrc(msg) v3fatalSrc(msg)
@@ -34,6 +35,25 @@
 class VInFilter;
 class VSpellCheck;
 
+// One `define, as saved and restored by --preproc-cache-dir
+struct V3PreProcDefine final {
+    string m_name;  // Name of the define
+    string m_value;  // Value of define
+    string m_params;  // Parameters
+    bool m_cmdline;  // Set on command line
+    string m_filename;  // Where it was declared
+    int m_lineno;  // Where it was declared
+};
+
+// Defines a file depended on and changed, as tracked by --preproc-jobs
+struct V3PreProcDefinesUse final {
+    std::vector<V3PreProcDefine> m_readDefined;  // Read before any change, value then
+    std::vector<string> m_readUndefined;  // Read before any change, undefined then
+    std::vector<V3PreProcDefine> m_wroteDefined;  // Changed, value after
+    std::vector<string> m_wroteUndefined;  // Changed, undefined after
+    bool m_all = false;  // `undefineall or restore, depends on and changes every define
+};
+
 class V3PreProc VL_NOT_FINAL {
     // This defines a preprocessor.  Functions are virtual so implementation can be hidden.
     // After creating, call open(), then getline() in a loop.  The class will to the rest...
@@ -86,6 +106,18 @@ public:
         define(fileline, name, value, "", true);
     }
     virtual string removeDefines(const string& text) = 0;  // Remove defines in a text string
+    // Return all defines, in name order
+    virtual std::vector<V3PreProcDefine> definesSave() const = 0;
+    // Replace all defines with ones from definesSave()
+    virtual void definesRestore(const std::vector<V3PreProcDefine>& defines) = 0;
+    // Start recording the defines read and changed, e.g. while preprocessing a file
+    virtual void definesTrackStart() = 0;
+    // Stop recording, and return what was read and changed since definesTrackStart()
+    virtual V3PreProcDefinesUse definesTrackStop() = 0;
+    // True if the defines read have the values they had when recorded
+    virtual bool definesMatch(const V3PreProcDefinesUse& use) const = 0;
+    // Make the recorded changes
+    virtual void definesApply(const V3PreProcDefinesUse& use) = 0;
 
     // UTILITIES
     void error(const string& msg) { fileline()->v3error(msg); }  ///< Report an error
@@ -24,12 +24,252 @@
 #include "V3Os.h"
 #include "V3Parse.h"
 #include "V3PreProc.h"
+#include "V3Stats.h"
+#include "V3String.h"
 
 #include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
 
 VL_DEFINE_DEBUG_FUNCTIONS;
 
+//######################################################################
+// Length-prefixed strings, for files holding preprocessor output
+
+static void writeString(std::ostream& os, const string& str) { os << str.size() << ':' << str; }
+static bool readString(std::istream& is, string& str) {
+    size_t size = 0;
+    if (!(is >> size) || is.get() != ':') return false;
+    str.resize(size);
+    return !size || is.read(&str[0], size);
+}
+static bool readInt(std::istream& is, size_t& value) {
+    string str;
+    if (!readString(is, str)) return false;
+    value = std::atol(str.c_str());
+    return true;
+}
+
+// Defines, with where each was declared
+static void writeDefines(std::ostream& os, const std::vector<V3PreProcDefine>& defines) {
+    writeString(os, cvtToStr(defines.size()));
+    for (const V3PreProcDefine& def : defines) {
+        writeString(os, def.m_name);
+        writeString(os, def.m_value);
+        writeString(os, def.m_params);
+        writeString(os, cvtToStr(def.m_cmdline));
+        writeString(os, def.m_filename);
+        writeString(os, cvtToStr(def.m_lineno));
+    }
+}
+static bool readDefines(std::istream& is, std::vector<V3PreProcDefine>& defines) {
+    size_t count = 0;
+    if (!readInt(is, count)) return false;
+    defines.resize(count);
+    for (V3PreProcDefine& def : defines) {
+        size_t cmdline = 0;
+        size_t lineno = 0;
+        if (!readString(is, def.m_name) || !readString(is, def.m_value)
+            || !readString(is, def.m_params) || !readInt(is, cmdline)
+            || !readString(is, def.m_filename) || !readInt(is, lineno)) {
+            return false;
+        }
+        def.m_cmdline = cmdline;
+        def.m_lineno = lineno;
+    }
+    return true;
+}
+static void writeNames(std::ostream& os, const std::vector<string>& names) {
+    writeString(os, cvtToStr(names.size()));
+    for (const string& name : names) writeString(os, name);
+}
+static bool readNames(std::istream& is, std::vector<string>& names) {
+    size_t count = 0;
+    if (!readInt(is, count)) return false;
+    names.resize(count);
+    for (string& name : names) {
+        if (!readString(is, name)) return false;
+    }
+    return true;
+}
+static void writeDefinesUse(std::ostream& os, const V3PreProcDefinesUse& use) {
+    writeDefines(os, use.m_readDefined);
+    writeNames(os, use.m_readUndefined);
+    writeDefines(os, use.m_wroteDefined);
+    writeNames(os, use.m_wroteUndefined);
+    writeString(os, use.m_all ? "1" : "0");
+}
+static bool readDefinesUse(std::istream& is, V3PreProcDefinesUse& use) {
+    string all;
+    if (!readDefines(is, use.m_readDefined) || !readNames(is, use.m_readUndefined)
+        || !readDefines(is, use.m_wroteDefined) || !readNames(is, use.m_wroteUndefined)
+        || !readString(is, all)) {
+        return false;
+    }
+    use.m_all = all == "1";
+    return true;
+}
+// What preprocessing output depends on in the defines
+static void writeDefinesKey(std::ostream& os, const std::vector<V3PreProcDefine>& defines) {
+    for (const V3PreProcDefine& def : defines) {
+        writeString(os, def.m_name);
+        writeString(os, def.m_params);
+        writeString(os, def.m_value);
+        os << def.m_cmdline;
+    }
+}
+
+//######################################################################
+// Preprocessor output cache, for --preproc-cache-dir
+//
+// An entry is named by the digest of the file's name and contents, the
+// defines in effect before it, and the options the preprocessor consults.
+// It holds the output text, the defines in effect after it, and each
+// `include resolution and file read, which must all still match.
+
+class V3PreProcCache final {
+    // TYPES
+    struct Include final {
+        string m_modname;  // Name as `included
+        string m_lastpath;  // Directory of the including file
+        string m_filename;  // Resolved filename
+    };
+
+    // MEMBERS
+    std::map<const string, string> m_digests;  // Contents digest of each file, for this run
+    bool m_recording = false;  // Recording includes of a file being preprocessed
+    std::vector<Include> m_includes;  // Includes resolved while recording
+    std::vector<string> m_deps;  // Files read while recording
+
+    // METHODS
+    string entryFilename(const string& key) const {
+        return v3Global.opt.preprocCacheDir() + "/" + key + ".vpp";
+    }
+
+public:
+    bool enabled() const {
+        // A --pipe-filter may give different text for the same file
+        return !v3Global.opt.preprocCacheDir().empty() && v3Global.opt.pipeFilter().empty();
+    }
+    const string& fileDigest(const string& filename) {
+        const auto it = m_digests.find(filename);
+        if (it != m_digests.end()) return it->second;
+        string digest;
+        const std::unique_ptr<std::ifstream> ifp{V3File::new_ifstream_nodepend(filename)};
+        if (!ifp->fail()) {
+            std::ostringstream contents;
+            contents << ifp->rdbuf();
+            digest = VHashSha256{contents.str()}.digestHex();
+        }
+        return m_digests.emplace(filename, digest).first->second;
+    }
+    string key(V3PreProc* preprocp, const string& filename) {
+        std::ostringstream os;
+        writeString(os, V3Options::version());
+        writeString(os, filename);
+        writeString(os, fileDigest(filename));
+        os << v3Global.opt.preprocOnly() << v3Global.opt.preprocNoLine()
+           << v3Global.opt.ppComments() << v3Global.opt.assertOn() << v3Global.opt.pedantic();
+        writeDefinesKey(os, preprocp->definesSave());
+        return VHashSha256{os.str()}.digestHex();
+    }
+
+    // Recording a preprocessor run, to store()
+    void recordStart() {
+        m_recording = true;
+        m_includes.clear();
+        m_deps.clear();
+    }
+    void recordOpen(const string& modname, const string& lastpath, const string& filename) {
+        if (!m_recording) return;
+        if (!lastpath.empty() || modname != filename) {
+            m_includes.push_back({modname, lastpath, filename});
+        }
+        m_deps.push_back(filename);
+    }
+    void store(V3PreProc* preprocp, const string& key, const string& text) {
+        m_recording = false;
+        std::ostringstream os;
+        os << "verilator-preproc-cache\n";
+        writeString(os, cvtToStr(m_deps.size()));
+        for (const string& filename : m_deps) {
+            writeString(os, filename);
+            writeString(os, fileDigest(filename));
+        }
+        writeString(os, cvtToStr(m_includes.size()));
+        for (const Include& inc : m_includes) {
+            writeString(os, inc.m_modname);
+            writeString(os, inc.m_lastpath);
+            writeString(os, inc.m_filename);
+        }
+        writeDefines(os, preprocp->definesSave());
+        writeString(os, text);
+        // Write then rename, as other runs may be reading the same entry
+        V3Os::createDir(v3Global.opt.preprocCacheDir());
+        const string filename = entryFilename(key);
+        const string tmpFilename
+            = filename + "." + VHashSha256{V3Os::trueRandom(16)}.digestHex().substr(0, 16);
+        {
+            const std::unique_ptr<std::ofstream> ofp{V3File::new_ofstream_nodepend(tmpFilename)};
+            if (ofp->fail()) return;  // Caching is only an optimization
+            *ofp << os.str();
+        }
+        if (std::rename(tmpFilename.c_str(), filename.c_str()) != 0) {
+            std::remove(tmpFilename.c_str());
+        }
+        UINFO(4, "    Stored preprocessor cache " << filename << endl);
+    }
+    void recordAbort() { m_recording = false; }
+
+    // Return true with the output text if there is a usable entry
+    template <typename T_Resolve>
+    bool lookup(V3PreProc* preprocp, const string& key, T_Resolve resolve, string& text) {
+        const string filename = entryFilename(key);
+        const std::unique_ptr<std::ifstream> ifp{V3File::new_ifstream_nodepend(filename)};
+        if (ifp->fail()) return false;
+        std::istream& is = *ifp;
+        if (V3Os::getline(is) != "verilator-preproc-cache") return false;
+        size_t count = 0;
+        std::vector<string> deps;
+        if (!readInt(is, count)) return false;
+        for (size_t i = 0; i < count; ++i) {
+            string dep;
+            string digest;
+            if (!readString(is, dep) || !readString(is, digest)) return false;
+            if (fileDigest(dep) != digest) {
+                UINFO(4, "    Preprocessor cache stale, changed " << dep << endl);
+                return false;
+            }
+            deps.push_back(dep);
+        }
+        if (!readInt(is, count)) return false;
+        for (size_t i = 0; i < count; ++i) {
+            Include inc;
+            if (!readString(is, inc.m_modname) || !readString(is, inc.m_lastpath)
+                || !readString(is, inc.m_filename)) {
+                return false;
+            }
+            if (resolve(inc.m_modname, inc.m_lastpath) != inc.m_filename) {
+                UINFO(4, "    Preprocessor cache stale, now resolves " << inc.m_modname << endl);
+                return false;
+            }
+        }
+        std::vector<V3PreProcDefine> defines;
+        if (!readDefines(is, defines)) return false;
+        if (!readString(is, text)) return false;
+        // Usable; apply the side effects preprocessing would have had
+        for (const string& dep : deps) V3File::addSrcDepend(dep);
+        preprocp->definesRestore(defines);
+        UINFO(4, "    Using preprocessor cache " << filename << endl);
+        return true;
+    }
+};
+
 //######################################################################
 
 class V3PreShellImp final {
@@ -39,10 +279,25 @@ protected:
     static V3PreShellImp s_preImp;
     static V3PreProc* s_preprocp;
     static VInFilter* s_filterp;
+    static V3PreProcCache s_cache;
+
+    // TYPES
+    struct Prepared final {  // Output of a --preproc-jobs worker for one file
+        string m_text;  // Preprocessed text
+        V3PreProcDefinesUse m_use;  // Defines the file read and changed
+    };
+
+    std::map<const string, Prepared> m_prepared;  // Output of --preproc-jobs workers, by modname
 
     //---------------------------------------
     // METHODS
 
+    void reset() {
+        if (s_preprocp) VL_DO_CLEAR(delete s_preprocp, s_preprocp = nullptr);
+        s_filterp = nullptr;
+        s_cache = V3PreProcCache{};
+        m_prepared.clear();
+    }
     void boot() {
         // Create the implementation pointer
         if (!s_preprocp) {
@@ -85,7 +340,7 @@ protected:
 
         // Preprocess
         s_filterp = filterp;
-        const string modfilename = preprocOpen(fl, s_filterp, modname, "", errmsg);
+        const string modfilename = preprocResolve(fl, modname, "", errmsg);
         if (modfilename.empty()) return false;
 
         // Set language standard up front
@@ -101,13 +356,183 @@ protected:
             // FileLine tracks and frees modfileline
         }
 
+        const auto it = m_prepared.find(modname);
+        if (it != m_prepared.end()) {
+            const Prepared prepared = std::move(it->second);
+            m_prepared.erase(it);
+            // Usable only if each define the file read has the value the worker saw
+            if (s_preprocp->definesMatch(prepared.m_use)) {
+                UINFO(4, "    Using output of --preproc-jobs for " << modname << endl);
+                if (v3Global.opt.stats()) {
+                    V3Stats::addStatSum("Preprocessor, files prepared in parallel used", 1);
+                }
+                s_preprocp->definesApply(prepared.m_use);
+                V3Parse::ppPushText(parsep, prepared.m_text);
+                return true;
+            }
+            UINFO(4, "    Defines read differ from --preproc-jobs worker for " << modname
+                                                                                << endl);
+            if (v3Global.opt.stats()) {
+                V3Stats::addStatSum("Preprocessor, files preprocessed again", 1);
+            }
+        }
+
+        preprocFile(fl, modfilename,
+                    [parsep](const string& text) { V3Parse::ppPushText(parsep, text); });
+        return true;
+    }
+
+    // Preprocess a resolved filename, passing the output to emit()
+    template <typename T_Emit>
+    void preprocFile(FileLine* fl, const string& modfilename, T_Emit emit) {
+        string key;
+        if (s_cache.enabled()) {
+            key = s_cache.key(s_preprocp, modfilename);
+            const auto resolve = [this, fl](const string& incname, const string& lastpath) {
+                return preprocResolve(fl, incname, lastpath, "");
+            };
+            string text;
+            if (s_cache.lookup(s_preprocp, key, resolve, text /*ref*/)) {
+                emit(text);
+                return;
+            }
+            s_cache.recordStart();
+        }
+        const int messages = V3Error::errorCount() + V3Error::warnCount();
+
+        preprocOpenResolved(fl, s_filterp, modfilename, "", modfilename);
+        string text;
         while (!s_preprocp->isEof()) {
             const string line = s_preprocp->getline();
-            V3Parse::ppPushText(parsep, line);
+            emit(line);
+            if (!key.empty()) text += line;
         }
-        return true;
+
+        // Messages would not be repeated from the cache, so don't cache
+        if (!key.empty() && messages == V3Error::errorCount() + V3Error::warnCount()) {
+            s_cache.store(s_preprocp, key, text);
+        } else {
+            s_cache.recordAbort();
+        }
+    }
+
+    void preprocParallel(VInFilter* filterp, const std::vector<string>& modnames) {
+        // Preprocess files in forked workers, leaving output for preproc()
+        const size_t jobs = std::min<size_t>(v3Global.opt.preprocJobs(), modnames.size());
+        if (jobs < 2) return;
+        if (!v3Global.opt.pipeFilter().empty()) return;  // Filter is one process
+        s_filterp = filterp;
+        V3File::createMakeDir();
+        std::vector<std::pair<int, string>> workers;
+        for (size_t job = 0; job < jobs; ++job) {
+            const string filename = v3Global.opt.hierTopDataDir() + "/" + v3Global.opt.prefix()
+                                    + "__preproc" + cvtToStr(job) + ".dat";
+            const int pid = V3Os::forkProcess();
+            if (pid == 0) preprocWorker(modnames, job, jobs, filename);  // Does not return
+            workers.emplace_back(pid, filename);
+        }
+        // Read in job order, so results do not depend on timing
+        for (const auto& itr : workers) {
+            const int exitCode = V3Os::waitProcess(itr.first);
+            if (exitCode == 0) readPrepared(itr.second);
+            std::remove(itr.second.c_str());
+        }
+        if (v3Global.opt.stats()) {
+            V3Stats::addStat("Preprocessor, files prepared in parallel", m_prepared.size());
+        }
+    }
+
+private:
+    [[noreturn]] void preprocWorker(const std::vector<string>& modnames, size_t job, size_t jobs,
+                                    const string& filename) {
+        // Messages are reported by the parent, which preprocesses any file
+        // that had messages itself, in order
+        std::cout.rdbuf(nullptr);
+        std::cerr.rdbuf(nullptr);
+        const std::vector<string> depsBefore = V3File::getAllDeps();
+        // Each worker takes a contiguous run of files, carrying defines from one
+        // file to the next as a single job would.  The first file of a run starts
+        // from the defines before any file.  Which defines each file read before
+        // changing them, and their values, are recorded, so the parent only
+        // preprocesses again a file that read a define an earlier file changed.
+        const size_t perJob = (modnames.size() + jobs - 1) / jobs;
+        const size_t begin = std::min(job * perJob, modnames.size());
+        const size_t end = std::min(begin + perJob, modnames.size());
+        std::ostringstream os;
+        writeString(os, cvtToStr(end - begin));
+        for (size_t i = begin; i < end; ++i) {
+            const string& modname = modnames[i];
+            const int messages = V3Error::errorCount() + V3Error::warnCount();
+            FileLine* const fl = new FileLine{FileLine::commandLineFilename()};
+            const string modfilename = preprocResolve(fl, modname, "", "");
+            string text;
+            s_preprocp->definesTrackStart();
+            if (!modfilename.empty()) {
+                preprocFile(fl, modfilename, [&text](const string& line) { text += line; });
+            }
+            const V3PreProcDefinesUse use = s_preprocp->definesTrackStop();
+            const bool ok
+                = !modfilename.empty() && messages == V3Error::errorCount() + V3Error::warnCount();
+            writeString(os, modname);
+            writeString(os, ok ? "1" : "0");
+            writeString(os, ok ? text : "");
+            writeDefinesUse(os, use);
+        }
+        // Files read, for the parent's dependency list
+        const std::set<string> before{depsBefore.begin(), depsBefore.end()};
+        std::vector<string> deps;
+        for (const string& dep : V3File::getAllDeps()) {
+            if (!before.count(dep)) deps.push_back(dep);
+        }
+        writeString(os, cvtToStr(deps.size()));
+        for (const string& dep : deps) writeString(os, dep);
+        // Files looked for, for the parent's --checkpoint-dir
+        const std::map<const string, bool>& probes = v3Global.opt.fileProbes();
+        writeString(os, cvtToStr(probes.size()));
+        for (const auto& itr : probes) {
+            writeString(os, itr.first);
+            writeString(os, itr.second ? "1" : "0");
+        }
+        {
+            const std::unique_ptr<std::ofstream> ofp{V3File::new_ofstream_nodepend(filename)};
+            *ofp << os.str();
+            if (ofp->fail()) std::_Exit(1);
+        }
+        std::_Exit(0);
+    }
+    void readPrepared(const string& filename) {
+        const std::unique_ptr<std::ifstream> ifp{V3File::new_ifstream_nodepend(filename)};
+        std::istream& is = *ifp;
+        size_t count = 0;
+        if (!readInt(is, count)) return;
+        std::map<const string, Prepared> prepared;
+        for (size_t i = 0; i < count; ++i) {
+            string modname;
+            string ok;
+            Prepared entry;
+            if (!readString(is, modname) || !readString(is, ok) || !readString(is, entry.m_text)
+                || !readDefinesUse(is, entry.m_use)) {
+                return;
+            }
+            if (ok == "1") prepared.emplace(modname, std::move(entry));
+        }
+        if (!readInt(is, count)) return;
+        std::vector<string> deps(count);
+        for (string& dep : deps) {
+            if (!readString(is, dep)) return;
+        }
+        if (!readInt(is, count)) return;
+        std::vector<std::pair<string, string>> probes(count);
+        for (auto& probe : probes) {
+            if (!readString(is, probe.first) || !readString(is, probe.second)) return;
+        }
+        // Complete, so use it
+        for (const string& dep : deps) V3File::addSrcDepend(dep);
+        for (const auto& probe : probes) v3Global.opt.fileProbed(probe.first, probe.second == "1");
+        m_prepared.insert(prepared.begin(), prepared.end());
     }
 
+protected:
     void preprocInclude(FileLine* fl, const string& modname) {
         if (modname[0] == '/' || modname[0] == '\\') {
             fl->v3warn(INCABSPATH,
@@ -119,10 +544,9 @@ protected:
     }
 
 private:
-    string preprocOpen(FileLine* fl, VInFilter* filterp, const string& modname,
-                       const string& lastpath,
-                       const string& errmsg) {  // Error message or "" to suppress
-        // Returns filename if successful
+    string preprocResolve(FileLine* fl, const string& modname, const string& lastpath,
+                          const string& errmsg) {  // Error message or "" to suppress
+        // Returns filename if found
         // Try a pure name in case user has a bogus `filename they don't expect
         string filename = v3Global.opt.filePath(fl, modname, lastpath, errmsg);
         if (filename == "") {
@@ -132,11 +556,22 @@ private:
 
             filename = v3Global.opt.filePath(fl, ppmodname, lastpath, errmsg);
         }
+        return filename;
+    }
+    string preprocOpen(FileLine* fl, VInFilter* filterp, const string& modname,
+                       const string& lastpath,
+                       const string& errmsg) {  // Error message or "" to suppress
+        // Returns filename if successful
+        const string filename = preprocResolve(fl, modname, lastpath, errmsg);
         if (filename == "") return "";  // Not found
-
+        preprocOpenResolved(fl, filterp, modname, lastpath, filename);
+        return filename;
+    }
+    void preprocOpenResolved(FileLine* fl, VInFilter* filterp, const string& modname,
+                             const string& lastpath, const string& filename) {
         UINFO(2, "    Reading " << filename << endl);
+        s_cache.recordOpen(modname, lastpath, filename);
         s_preprocp->openFile(fl, filterp, filename);
-        return filename;
     }
 
 public:
@@ -148,11 +583,16 @@ public:
 V3PreShellImp V3PreShellImp::s_preImp;
 V3PreProc* V3PreShellImp::s_preprocp = nullptr;
 VInFilter* V3PreShellImp::s_filterp = nullptr;
+V3PreProcCache V3PreShellImp::s_cache;
 
 //######################################################################
 // V3PreShell
 
 void V3PreShell::boot() { V3PreShellImp::s_preImp.boot(); }
+void V3PreShell::reset() { V3PreShellImp::s_preImp.reset(); }
+void V3PreShell::preprocParallel(VInFilter* filterp, const std::vector<string>& modnames) {
+    V3PreShellImp::s_preImp.preprocParallel(filterp, modnames);
+}
 bool V3PreShell::preproc(FileLine* fl, const string& modname, VInFilter* filterp,
                          V3ParseImp* parsep, const string& errmsg) {
     return V3PreShellImp::s_preImp.preproc(fl, modname, filterp, parsep, errmsg);
@@ -169,3 +609,9 @@ void V3PreShell::dumpDefines(std::ostream& os) { V3PreShellImp::s_preprocp->dump
 void V3PreShell::candidateDefines(VSpellCheck* spellerp) {
     V3PreShellImp::s_preprocp->candidateDefines(spellerp);
 }
+std::vector<V3PreProcDefine> V3PreShell::definesSave() {
+    return V3PreShellImp::s_preprocp->definesSave();
+}
+void V3PreShell::definesRestore(const std::vector<V3PreProcDefine>& defines) {
+    V3PreShellImp::s_preprocp->definesRestore(defines);
+}
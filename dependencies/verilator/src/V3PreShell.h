@@ -23,9 +23,12 @@
 #include "V3Error.h"
 #include "V3FileLine.h"
 
+#include <vector>
+
 class V3ParseImp;
 class VInFilter;
 class VSpellCheck;
+struct V3PreProcDefine;
 
 //============================================================================
 
@@ -33,6 +36,9 @@ class V3PreShell final {
     // Static class for calling preprocessor
 public:
     static void boot();
+    static void reset();  // Drop the preprocessor and its defines, to Verilate again
+    // For --preproc-jobs, preprocess files ahead of preproc() calls for them
+    static void preprocParallel(VInFilter* filterp, const std::vector<string>& modnames);
     static bool preproc(FileLine* fl, const string& modname, VInFilter* filterp,
                         V3ParseImp* parsep, const string& errmsg);
     static void preprocInclude(FileLine* fl, const string& modname);
@@ -40,6 +46,9 @@ public:
     static void undef(const string& name);
     static void dumpDefines(std::ostream& os);
     static void candidateDefines(VSpellCheck* spellerp);
+    // All defines, e.g. to later read a file as if it were read before others
+    static std::vector<V3PreProcDefine> definesSave();
+    static void definesRestore(const std::vector<V3PreProcDefine>& defines);
 };
 
 #endif  // Guard
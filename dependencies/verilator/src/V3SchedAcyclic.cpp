@@ -31,12 +31,20 @@
 // variables is converted into hybrid logic, with the back-edge driven
 // variables listed as explicit 'changed' sensitivities.
 //
+// With --scc-iterate, each strongly connected component (SCC) consisting of
+// only pure combinational logic is instead merged into a single hybrid
+// process, which evaluates the logic of the SCC in dependency order in a
+// local loop until the cut variables of the SCC stabilize. This avoids
+// re-evaluating the whole combinational region for every iteration of a
+// small feedback loop.
+//
 //*************************************************************************
 
 #include "config_build.h"
 #include "verilatedos.h"
 
 #include "V3Ast.h"
+#include "V3EmitCBase.h"
 #include "V3Error.h"
 #include "V3Global.h"
 #include "V3Graph.h"
@@ -45,8 +53,10 @@
 #include "V3SplitVar.h"
 #include "V3Stats.h"
 
+#include <map>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -345,7 +355,8 @@ void reportCycles(Graph* graphp, const std::vector<VarVertex*>& cutVertices) {
     }
 }
 
-LogicByScope fixCuts(AstNetlist* netlistp, const std::vector<VarVertex*>& cutVertices) {
+LogicByScope fixCuts(AstNetlist* netlistp, const std::vector<VarVertex*>& cutVertices,
+                     const std::unordered_set<uint32_t>& iteratedSccs) {
     // For all logic that reads a cut vertex, build a map from logic -> list of cut AstVarScope
     // they read. Also build a vector of the involved logic for deterministic results.
     std::unordered_map<LogicVertex*, std::vector<AstVarScope*>> lvtx2Cuts;
@@ -353,8 +364,13 @@ LogicByScope fixCuts(AstNetlist* netlistp, const std::vector<VarVertex*>& cutVer
     {
         const VNUser1InUse user1InUse;  // bool: already added to 'lvtxps'
         for (VarVertex* const vvtxp : cutVertices) {
+            // SCCs evaluated in a local loop need no fixing
+            if (iteratedSccs.count(vvtxp->color())) continue;
             for (V3GraphEdge* edgep = vvtxp->outBeginp(); edgep; edgep = edgep->outNextp()) {
                 LogicVertex* const lvtxp = static_cast<LogicVertex*>(edgep->top());
+                // Logic already merged into an SCC loop (it is ordered normally, as the
+                // dependency on a cut variable of a different SCC cannot form a cycle)
+                if (iteratedSccs.count(lvtxp->color())) continue;
                 if (!lvtxp->logicp()->user1SetOnce()) lvtxps.push_back(lvtxp);
                 lvtx2Cuts[lvtxp].push_back(vvtxp->vscp());
             }
@@ -385,6 +401,178 @@ LogicByScope fixCuts(AstNetlist* netlistp, const std::vector<VarVertex*>& cutVer
     return result;
 }
 
+// Can this logic be evaluated repeatedly in an SCC loop?
+bool isSccIterableLogic(const AstNode* logicp) {
+    if (const AstAlways* const alwaysp = VN_CAST(logicp, Always)) {
+        if (alwaysp->sensesp()) return false;
+    } else if (!VN_IS(logicp, AssignW)) {
+        return false;
+    }
+    // Re-evaluation must have no observable effects
+    return !logicp->exists([](const AstNode* nodep) {
+        return !nodep->isPure() || nodep->isOutputter() || nodep->isTimingControl()
+               || VN_IS(nodep, NodeCCall) || VN_IS(nodep, CStmt) || VN_IS(nodep, NodeFTaskRef);
+    });
+}
+
+// Can this cut variable be compared for convergence of an SCC loop?
+bool isSccComparableVar(const AstVarScope* vscp) {
+    const AstNodeDType* const dtypep = vscp->dtypep()->skipRefp();
+    if (const AstBasicDType* const basicp = VN_CAST(dtypep, BasicDType)) {
+        return !basicp->isDouble() && !basicp->isString() && !basicp->isOpaque()
+               && !basicp->isEvent();
+    }
+    if (VN_IS(dtypep, PackArrayDType)) return true;
+    if (const AstNodeUOrStructDType* const sdtypep = VN_CAST(dtypep, NodeUOrStructDType)) {
+        return sdtypep->packed();
+    }
+    return false;
+}
+
+AstConst* newSccConst(AstVarScope* vscp, uint32_t val) {
+    AstConst* const constp = new AstConst{vscp->fileline(), AstConst::DTyped{}, vscp->dtypep()};
+    constp->num().setLong(val);
+    return constp;
+}
+
+// Build the process evaluating the given SCC logic (in rank order) until the values of the
+// given cut variables stabilize. The original logic is unlinked and deleted.
+AstAlways* buildSccLoop(uint32_t id, AstScope* scopep, const std::vector<LogicVertex*>& lvtxps,
+                        const std::vector<AstVarScope*>& cutps) {
+    FileLine* const flp = lvtxps.front()->logicp()->fileline();
+    const string prefix = "__Vscc" + cvtToStr(id);
+    AstVarScope* const continuep = scopep->createTemp(prefix + "Continue", 1);
+    AstVarScope* const counterp = scopep->createTemp(prefix + "IterCount", 32);
+
+    AstNode* const stmtsp = new AstAssign{flp, new AstVarRef{flp, continuep, VAccess::WRITE},
+                                          newSccConst(continuep, 1)};
+    stmtsp->addNext(new AstAssign{flp, new AstVarRef{flp, counterp, VAccess::WRITE},
+                                  newSccConst(counterp, 0)});
+    AstWhile* const loopp = new AstWhile{flp, new AstVarRef{flp, continuep, VAccess::READ}};
+    stmtsp->addNext(loopp);
+
+    // Count iterations, and die if we exceeded the iteration limit
+    loopp->addStmtsp(new AstAssign{
+        flp, new AstVarRef{flp, counterp, VAccess::WRITE},
+        new AstAdd{flp, new AstVarRef{flp, counterp, VAccess::READ}, newSccConst(counterp, 1)}});
+    {
+        AstConst* const limitp = newSccConst(counterp, v3Global.opt.convergeLimit());
+        AstNodeMath* const condp
+            = new AstGt{flp, new AstVarRef{flp, counterp, VAccess::READ}, limitp};
+        AstIf* const failp = new AstIf{flp, condp};
+        loopp->addStmtsp(failp);
+        AstTextBlock* const blockp = new AstTextBlock{flp};
+        failp->addThensp(blockp);
+        const string& file = EmitCBaseVisitor::protect(flp->filename());
+        const string& line = cvtToStr(flp->lineno());
+        blockp->addText(flp, "VL_FATAL_MT(\"" + file + "\", " + line + ", \"\", ", true);
+        blockp->addText(flp, "\"Combinational loop did not converge.\");\n", true);
+    }
+
+    // Save the values of the cut variables
+    std::vector<AstVarScope*> prevps;
+    for (AstVarScope* const vscp : cutps) {
+        AstVarScope* const prevp
+            = scopep->createTempLike(prefix + "Prev" + cvtToStr(prevps.size()), vscp);
+        prevps.push_back(prevp);
+        loopp->addStmtsp(new AstAssign{flp, new AstVarRef{flp, prevp, VAccess::WRITE},
+                                       new AstVarRef{flp, vscp, VAccess::READ}});
+    }
+
+    // Evaluate the logic
+    for (LogicVertex* const lvtxp : lvtxps) {
+        AstNode* const logicp = lvtxp->logicp()->unlinkFrBack();
+        if (AstAssignW* const assignp = VN_CAST(logicp, AssignW)) {
+            loopp->addStmtsp(new AstAssign{assignp->fileline(), assignp->lhsp()->unlinkFrBack(),
+                                           assignp->rhsp()->unlinkFrBack()});
+        } else if (AstNode* const bodyp = VN_AS(logicp, Always)->stmtsp()) {
+            loopp->addStmtsp(bodyp->unlinkFrBackWithNext());
+        }
+        VL_DO_DANGLING(logicp->deleteTree(), logicp);
+    }
+
+    // Iterate again if any of the cut variables changed
+    AstNode* changedp = nullptr;
+    for (size_t i = 0; i < cutps.size(); ++i) {
+        AstNode* const neqp = new AstNeq{flp, new AstVarRef{flp, cutps[i], VAccess::READ},
+                                         new AstVarRef{flp, prevps[i], VAccess::READ}};
+        changedp = changedp ? new AstOr{flp, changedp, neqp} : neqp;
+    }
+    loopp->addStmtsp(
+        new AstAssign{flp, new AstVarRef{flp, continuep, VAccess::WRITE}, changedp});
+
+    // Record the number of iterations taken
+    if (v3Global.opt.profExec()) {
+        AstCStmt* const recordp = new AstCStmt{
+            flp, "VL_EXEC_TRACE_ADD_RECORD(vlSymsp).sccLoop(" + cvtToStr(id) + ", "};
+        recordp->addExprsp(new AstVarRef{flp, counterp, VAccess::READ});
+        recordp->addExprsp(new AstText{flp, ");\n", true});
+        stmtsp->addNext(recordp);
+    }
+
+    return new AstAlways{flp, VAlwaysKwd::ALWAYS, nullptr, stmtsp};
+}
+
+// Replace the logic of eligible SCCs with SCC loops. The graph must be ranked with the cut
+// edges ignored. Returns the SCC loops as hybrid logic sensitive to the cut variables of the
+// SCC, and adds the color of each SCC handled to 'iteratedSccs'.
+LogicByScope iterateSccs(AstNetlist* netlistp, Graph* graphp,
+                         const std::vector<VarVertex*>& cutVertices,
+                         std::unordered_set<uint32_t>& iteratedSccs) {
+    // Gather the logic and the cut variables of each SCC, keyed by color
+    std::map<uint32_t, std::vector<LogicVertex*>> sccLogic;
+    std::map<uint32_t, std::vector<AstVarScope*>> sccCuts;
+    std::unordered_set<uint32_t> ineligible;
+    for (V3GraphVertex* vtxp = graphp->verticesBeginp(); vtxp; vtxp = vtxp->verticesNextp()) {
+        if (!vtxp->color()) continue;  // Not part of an SCC
+        if (LogicVertex* const lvtxp = dynamic_cast<LogicVertex*>(vtxp)) {
+            sccLogic[vtxp->color()].push_back(lvtxp);
+            if (!isSccIterableLogic(lvtxp->logicp())) ineligible.insert(vtxp->color());
+        }
+    }
+    for (VarVertex* const vvtxp : cutVertices) {
+        sccCuts[vvtxp->color()].push_back(vvtxp->vscp());
+        if (!isSccComparableVar(vvtxp->vscp())) ineligible.insert(vvtxp->color());
+    }
+
+    LogicByScope result;
+    SenTreeFinder finder{netlistp};
+    size_t nLogic = 0;
+    for (auto& pair : sccLogic) {
+        const uint32_t color = pair.first;
+        std::vector<LogicVertex*>& lvtxps = pair.second;
+        if (ineligible.count(color) || !sccCuts.count(color)) continue;
+        const std::vector<AstVarScope*>& cutps = sccCuts[color];
+        iteratedSccs.insert(color);
+        nLogic += lvtxps.size();
+
+        // Evaluate in dependency order
+        std::stable_sort(lvtxps.begin(), lvtxps.end(),
+                         [](const LogicVertex* ap, const LogicVertex* bp) {  //
+                             return ap->rank() < bp->rank();
+                         });
+        AstScope* const scopep = lvtxps.front()->scopep();
+        AstAlways* const alwaysp = buildSccLoop(iteratedSccs.size(), scopep, lvtxps, cutps);
+
+        // The loop is sensitive to changes of the cut variables made by other logic
+        FileLine* const flp = alwaysp->fileline();
+        AstSenItem* senItemsp = nullptr;
+        for (AstVarScope* const vscp : cutps) {
+            AstVarRef* const refp = new AstVarRef{flp, vscp, VAccess::READ};
+            AstSenItem* const nextp = new AstSenItem{flp, VEdgeType::ET_HYBRID, refp};
+            senItemsp = AstNode::addNext(senItemsp, nextp);
+        }
+        AstSenTree* const senTree = new AstSenTree{flp, senItemsp};
+        result.add(scopep, finder.getSenTree(senTree), alwaysp);
+        // SenTreeFinder::getSenTree clones, so clean up
+        VL_DO_DANGLING(senTree->deleteTree(), senTree);
+    }
+
+    V3Stats::addStat("Scheduling, SCC loops", iteratedSccs.size());
+    V3Stats::addStat("Scheduling, SCC loops, logic", nLogic);
+    return result;
+}
+
 }  // namespace
 
 LogicByScope breakCycles(AstNetlist* netlistp, LogicByScope& combinationalLogic) {
@@ -409,14 +597,26 @@ LogicByScope breakCycles(AstNetlist* netlistp, LogicByScope& combinationalLogic)
     // Find all cut vertices
     const std::vector<VarVertex*> cutVertices = findCutVertices(graphp.get());
 
+    // Rank while the cut edges are still marked, giving the evaluation order within SCCs
+    if (v3Global.opt.sccIterate()) graphp->rank();
+
     // Reset edge weights for reporting
     resetEdgeWeights(cutVertices);
 
     // Report warnings/diagnostics
     reportCycles(graphp.get(), cutVertices);
 
-    // Fix cuts by converting dependent logic to use hybrid sensitivities
-    return fixCuts(netlistp, cutVertices);
+    // Evaluate eligible SCCs in local loops
+    std::unordered_set<uint32_t> iteratedSccs;
+    LogicByScope sccLoops;
+    if (v3Global.opt.sccIterate()) {
+        sccLoops = iterateSccs(netlistp, graphp.get(), cutVertices, iteratedSccs);
+    }
+
+    // Fix remaining cuts by converting dependent logic to use hybrid sensitivities
+    LogicByScope result = fixCuts(netlistp, cutVertices, iteratedSccs);
+    result.insert(result.end(), sccLoops.begin(), sccLoops.end());
+    return result;
 }
 
 }  // namespace V3Sched
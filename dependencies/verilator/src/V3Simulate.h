@@ -1188,6 +1188,12 @@ public:
         setMode(false /*scoped*/, false /*checking*/, true /*params*/);
         mainGuts(nodep);
     }
+    void mainEvalEmulate(AstNode* nodep) {
+        // As for parameters, allow selects on the LHS and reading back assigned
+        // variables, as the whole block is evaluated rather than tabled
+        setMode(true /*scoped*/, false /*checking*/, true /*params*/);
+        mainGuts(nodep);
+    }
     ~SimulateVisitor() override {
         for (const auto& pair : m_constps) {
             for (AstConst* const constp : pair.second) { delete constp; }
@@ -121,6 +121,8 @@ public:
     static void statsFinalAll(AstNetlist* nodep);
     /// Called by the top level to dump the statistics
     static void statsReport();
+    /// Forget the statistics, to Verilate again
+    static void reset();
 };
 
 #endif  // Guard
@@ -173,6 +173,7 @@ class StatsReport final {
 public:
     // METHODS
     static void addStat(const V3Statistic& stat) { s_allStats.push_back(stat); }
+    static void clear() { s_allStats.clear(); }
 
     // CONSTRUCTORS
     explicit StatsReport(std::ofstream* aofp)
@@ -203,6 +204,8 @@ void V3Statistic::dump(std::ofstream& os) const {
 
 void V3Stats::addStat(const V3Statistic& stat) { StatsReport::addStat(stat); }
 
+void V3Stats::reset() { StatsReport::clear(); }
+
 void V3Stats::statsStage(const string& name) {
     static double lastWallTime = -1;
     static int fileNumber = 0;
@@ -222,6 +225,9 @@ void V3Stats::statsStage(const string& name) {
 void V3Stats::statsReport() {
     UINFO(2, __FUNCTION__ << ": " << endl);
 
+    const double peakMemory = V3Os::memPeakUsageBytes() / 1024.0 / 1024.0;
+    V3Stats::addStatPerf("Memory, Peak resident (MB)", peakMemory);
+
     // Open stats file
     const string filename
         = v3Global.opt.hierTopDataDir() + "/" + v3Global.opt.prefix() + "__stats.txt";
@@ -27,6 +27,7 @@
 #include "V3Case.h"
 #include "V3Cast.h"
 #include "V3Cdc.h"
+#include "V3Checkpoint.h"
 #include "V3Class.h"
 #include "V3Clean.h"
 #include "V3Clock.h"
@@ -46,8 +47,10 @@
 #include "V3EmitCMake.h"
 #include "V3EmitCSymExecMain.h"
 #include "V3EmitMk.h"
+#include "V3EmitSmt.h"
 #include "V3EmitV.h"
 #include "V3EmitXml.h"
+#include "V3EvalPatterns.h"
 #include "V3Expand.h"
 #include "V3File.h"
 #include "V3Force.h"
@@ -108,6 +111,8 @@ VL_DEFINE_DEBUG_FUNCTIONS;
 
 V3Global v3Global;
 
+static std::vector<int> s_forkPids;  // Backend processes started by --fork-config
+
 static void reportStatsIfEnabled() {
     if (v3Global.opt.stats()) {
         V3Stats::statsFinalAll(v3Global.rootp());
@@ -115,7 +120,38 @@ static void reportStatsIfEnabled() {
     }
 }
 
-static void process() {
+static void forkConfigs() {
+    // Each --fork-config gets a copy of the elaborated netlist in a child
+    // process, which then runs the remaining passes with its own options.
+    // This process continues with the options from the command line.
+    const V3StringList configs = v3Global.opt.forkConfigs();
+    for (const string& filename : configs) {
+        const int pid = V3Os::forkProcess();
+        if (pid == 0) {
+            s_forkPids.clear();
+            v3Global.opt.parseForkConfig(new FileLine{FileLine::commandLineFilename()}, filename);
+            V3Error::abortIfErrors();
+            UINFO(1, "--fork-config " << filename << ": Output to " << v3Global.opt.makeDir()
+                                      << endl);
+            return;
+        }
+        s_forkPids.push_back(pid);
+    }
+}
+
+static void waitForkConfigs() {
+    for (const int pid : s_forkPids) {
+        const int exit_code = V3Os::waitProcess(pid);
+        if (exit_code != 0) {
+            v3error("--fork-config backend process " << pid << " exited with " << exit_code);
+        }
+    }
+    s_forkPids.clear();
+    V3Error::abortIfErrors();
+}
+
+// Returns false if there is nothing more to do, as verilation follows a hierarchical plan
+static bool elaborate() {
     // Sort modules by level so later algorithms don't need to care
     V3LinkLevel::modSortByLevel();
     V3Error::abortIfErrors();
@@ -167,7 +203,7 @@ static void process() {
         // The actual Verilation will be done based on this plan.
         if (v3Global.hierPlanp()) {
             reportStatsIfEnabled();
-            return;
+            return false;
         }
     }
 
@@ -180,6 +216,18 @@ static void process() {
     V3Width::widthCommit(v3Global.rootp());
     v3Global.assertDTypesResolved(true);
     v3Global.widthMinUsage(VWidthMinUsage::MATCHES_WIDTH);
+    return true;
+}
+
+static void process(bool resumed) {
+    if (!resumed) {
+        if (!elaborate()) return;
+        // Frontend done; keep it for later runs with the same frontend options
+        if (!v3Global.opt.checkpointDir().empty()) V3Checkpoint::checkpoint();
+    }
+
+    // Run the backend once per --fork-config
+    if (!v3Global.opt.forkConfigs().empty()) forkConfigs();
 
     // Coverage insertion
     //    Before we do dead code elimination and inlining, or we'll lose it.
@@ -331,7 +379,8 @@ static void process() {
 
         // Make large low-fanin logic blocks into lookup tables
         // This should probably be done much later, once we have common logic elimination.
-        if (!v3Global.opt.lintOnly() && v3Global.opt.fTable()) {
+        if (!v3Global.opt.lintOnly() && v3Global.opt.evalPatterns().empty()
+            && v3Global.opt.fTable()) {
             V3Table::tableAll(v3Global.rootp());
         }
 
@@ -401,6 +450,20 @@ static void process() {
 
         if (v3Global.opt.stats()) V3Stats::statsStageAll(v3Global.rootp(), "PreOrder");
 
+        // Evaluate combinational logic on patterns, instead of making a model
+        if (!v3Global.opt.evalPatterns().empty()) {
+            V3EvalPatterns::evalPatternsAll(v3Global.rootp());
+            V3Error::abortIfErrors();
+            return;
+        }
+
+        // Write the transition relation, while the logic is still one block per process
+        if (v3Global.opt.smt2()) {
+            V3EmitSmt::emit(v3Global.rootp());
+            V3Error::abortIfErrors();
+            if (!v3Global.opt.outFormatOk()) return;
+        }
+
         // Schedule the logic
         V3Sched::schedule(v3Global.rootp());
 
@@ -581,10 +644,10 @@ static void process() {
         if (v3Global.opt.gmake()) V3EmitMk::emitmk();
     }
 
-    // Note early return above when opt.cdc()
+    // Note early return above when opt.cdc(), opt.evalPatterns() or opt.smt2() alone
 }
 
-static void verilate(const string& argString) {
+static void verilate() {
     UINFO(1, "Option --verilate: Start Verilation\n");
 
     // Can we skip doing everything if times are ok?
@@ -592,7 +655,7 @@ static void verilate(const string& argString) {
     if (v3Global.opt.skipIdentical().isTrue()
         && V3File::checkTimes(v3Global.opt.hierTopDataDir() + "/" + v3Global.opt.prefix()
                                   + "__verFiles.dat",
-                              argString)) {
+                              v3Global.opt.commandArgString())) {
         UINFO(1, "--skip-identical: No change to any source files, exiting\n");
         return;
     }
@@ -623,12 +686,14 @@ static void verilate(const string& argString) {
         V3Broken::selfTest();
     }
 
-    // Read first filename
-    v3Global.readFiles();
+    // Read first filename, unless a checkpoint of the same frontend is kept
+    const bool resumed = !v3Global.opt.checkpointDir().empty() && !v3Global.opt.preprocOnly()
+                         && V3Checkpoint::resume();
+    if (!resumed) v3Global.readFiles();
 
     // Link, etc, if needed
     if (!v3Global.opt.preprocOnly()) {  //
-        process();
+        process(resumed);
     }
 
     // Final steps
@@ -666,12 +731,16 @@ static void verilate(const string& argString) {
                                  + "__idmap.xml");
     }
 
-    if (v3Global.opt.skipIdentical().isTrue() || v3Global.opt.makeDepend().isTrue()) {
+    // Timestamps are only useful for files written to disk
+    if ((v3Global.opt.skipIdentical().isTrue() || v3Global.opt.makeDepend().isTrue())
+        && !VOutArchive::enabled()) {
         V3File::writeTimes(v3Global.opt.hierTopDataDir() + "/" + v3Global.opt.prefix()
                                + "__verFiles.dat",
-                           argString);
+                           v3Global.opt.commandArgString());
     }
 
+    if (VOutArchive::enabled()) VOutArchive::write();
+
     // Final writing shouldn't throw warnings, but...
     V3Error::abortIfWarnings();
     // Cleanup memory for valgrind leak analysis
@@ -723,7 +792,9 @@ static void execHierVerilation() {
 
 //######################################################################
 
-int main(int argc, char** argv, char** /*env*/) {
+// Run with the given command line; also the fuzzing entry point in
+// nodist/fuzzer calls this, after building with VL_FUZZER
+int verilatorMain(int argc, char** argv) {
     // General initialization
     std::ios::sync_with_stdio();
 
@@ -740,7 +811,6 @@ int main(int argc, char** argv, char** /*env*/) {
 
     // Command option parsing
     v3Global.opt.buildDepBin(argv[0]);
-    const string argString = V3Options::argString(argc - 1, argv + 1);
     v3Global.opt.parseOpts(new FileLine{FileLine::commandLineFilename()}, argc - 1, argv + 1);
 
     // Validate settings (aka Boost.Program_options)
@@ -750,19 +820,31 @@ int main(int argc, char** argv, char** /*env*/) {
     V3Error::abortIfErrors();
 
     if (v3Global.opt.verilate()) {
-        verilate(argString);
+        verilate();
     } else {
         UINFO(1, "Option --no-verilate: Skip Verilation\n");
     }
 
-    if (v3Global.hierPlanp() && v3Global.opt.gmake()) {
+    if (v3Global.hierPlanp() && v3Global.opt.gmake() && v3Global.opt.hierFork()) {
+        v3Global.hierPlanp()->verilateForked();
+        // All Verilation is up to date, so this only compiles
+        if (v3Global.opt.build()) execHierVerilation();
+    } else if (v3Global.hierPlanp() && v3Global.opt.gmake()) {
         execHierVerilation();  // execHierVerilation() takes care of --build too
     } else if (v3Global.opt.build()) {
         execBuildJob();
     }
 
+    // Backends forked by --fork-config must finish before we report success
+    waitForkConfigs();
+
     // Explicitly release resources
     v3Global.shutdown();
 
     UINFO(1, "Done, Exiting...\n");
+    return 0;
 }
+
+#ifndef VL_FUZZER
+int main(int argc, char** argv, char** /*env*/) { return verilatorMain(argc, argv); }
+#endif
@@ -0,0 +1,72 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2022 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+use IO::File;
+use strict;
+use vars qw($Self);
+
+# Times C++ emission of a large netlist; use --benchmark for a larger one
+scenarios(vlt => 1);
+
+my $mods = ($Self->{benchmark} ? 400 : 20);
+my $regs = 64;
+
+sub gen {
+    my $filename = shift;
+
+    my $fh = IO::File->new(">$filename");
+    $fh->print("// Generated by t_bench_emit.pl\n");
+    for (my $m = 0; $m < $mods; $m++) {
+        $fh->print("\n");
+        $fh->print("module sub${m} (input clk, input [63:0] i, output [63:0] o);\n");
+        for (my $r = 0; $r < $regs; $r++) {
+            $fh->print("   reg [63:0] r${r};\n");
+        }
+        $fh->print("   always @(posedge clk) begin\n");
+        $fh->print("      r0 <= i ^ 64'h${m}5a5a;\n");
+        for (my $r = 1; $r < $regs; $r++) {
+            my $p = $r - 1;
+            $fh->print("      if (r${p}[${r}]) r${r} <= (r${p} << 1) + {r${p}[31:0], 32'd${r}};\n");
+            $fh->print("      else r${r} <= r${p} - (r${r} >> 2);\n");
+        }
+        $fh->print("   end\n");
+        $fh->print("   assign o = r" . ($regs - 1) . ";\n");
+        $fh->print("endmodule\n");
+    }
+    $fh->print("\n");
+    $fh->print("module t (input clk, input [63:0] i, output [63:0] o);\n");
+    for (my $m = 0; $m < $mods; $m++) {
+        my $in = $m ? "o${m}_p" : "i";
+        $fh->print("   wire [63:0] o" . ($m + 1) . "_p;\n");
+        $fh->print("   sub${m} u${m} (.clk, .i(${in}), .o(o" . ($m + 1) . "_p));\n");
+    }
+    $fh->print("   assign o = o${mods}_p;\n");
+    $fh->print("endmodule\n");
+}
+
+top_filename("$Self->{obj_dir}/t_bench_emit.v");
+
+gen($Self->{top_filename});
+
+compile(
+    verilator_flags2 => ["--stats -Wno-UNOPTTHREADS"],
+    verilator_make_gmake => 0,
+    make_top_shell => 0,
+    make_main => 0,
+    );
+
+my $contents = file_contents($Self->{stats});
+if ($contents =~ /Stage, Elapsed time \(sec\), \d+_emit\s+([0-9.]+)/) {
+    print "Emit time for ${mods} modules: $1 sec\n";
+} else {
+    error("No emit stage time in $Self->{stats}");
+}
+
+ok(1);
+1;
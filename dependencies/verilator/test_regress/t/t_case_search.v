@@ -0,0 +1,112 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2022 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+
+   reg [23:0] addr;
+   reg [7:0]  sel;
+   reg [7:0]  dec;
+   reg [3:0]  grp;
+
+   // Sparse 24-bit address decode, with a range of equal items and a default
+   always @* begin
+      case (addr)
+        24'h000000: dec = 8'd1;
+        24'h000004: dec = 8'd2;
+        24'h000008: dec = 8'd3;
+        24'h000009: dec = 8'd3;
+        24'h00000a: dec = 8'd3;
+        24'h000100: dec = 8'd4;
+        24'h001000: dec = 8'd5;
+        24'h010000: dec = 8'd6;
+        24'h0f0000: dec = 8'd7;
+        24'h100000: dec = 8'd8;
+        24'h800000: dec = 8'd9;
+        24'hfffffe, 24'hffffff: dec = 8'd10;
+        24'h000004: dec = 8'd99;  // Overlaps, never selected
+        default: dec = 8'd0;
+      endcase
+   end
+
+   // Incomplete 8-bit case, no default
+   always @* begin
+      grp = 4'hf;
+      case (sel)
+        8'd3: grp = 4'd0;
+        8'd17: grp = 4'd1;
+        8'd18: grp = 4'd1;
+        8'd40: grp = 4'd2;
+        8'd64: grp = 4'd3;
+        8'd99: grp = 4'd4;
+        8'd128: grp = 4'd5;
+        8'd200: grp = 4'd6;
+        8'd255: grp = 4'd7;
+      endcase
+   end
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+`ifdef TEST_VERBOSE
+      $write("[%0t] cyc=%0d addr=%x dec=%0d sel=%0d grp=%0d\n", $time, cyc, addr, dec, sel, grp);
+`endif
+      case (cyc)
+        0: begin addr <= 24'h000000; sel <= 8'd0; end
+        1: begin
+           if (dec != 8'd1) $stop;
+           if (grp != 4'hf) $stop;
+           addr <= 24'h000004; sel <= 8'd3;
+        end
+        2: begin
+           if (dec != 8'd2) $stop;
+           if (grp != 4'd0) $stop;
+           addr <= 24'h000009; sel <= 8'd18;
+        end
+        3: begin
+           if (dec != 8'd3) $stop;
+           if (grp != 4'd1) $stop;
+           addr <= 24'h00000b; sel <= 8'd19;
+        end
+        4: begin
+           if (dec != 8'd0) $stop;
+           if (grp != 4'hf) $stop;
+           addr <= 24'h0f0000; sel <= 8'd99;
+        end
+        5: begin
+           if (dec != 8'd7) $stop;
+           if (grp != 4'd4) $stop;
+           addr <= 24'h0effff; sel <= 8'd255;
+        end
+        6: begin
+           if (dec != 8'd0) $stop;
+           if (grp != 4'd7) $stop;
+           addr <= 24'hfffffe; sel <= 8'd254;
+        end
+        7: begin
+           if (dec != 8'd10) $stop;
+           if (grp != 4'hf) $stop;
+           addr <= 24'hffffff; sel <= 8'd128;
+        end
+        8: begin
+           if (dec != 8'd10) $stop;
+           if (grp != 4'd5) $stop;
+           addr <= 24'h800000; sel <= 8'd200;
+        end
+        9: begin
+           if (dec != 8'd9) $stop;
+           if (grp != 4'd6) $stop;
+           $write("*-* All Finished *-*\n");
+           $finish;
+        end
+        default: ;
+      endcase
+   end
+endmodule
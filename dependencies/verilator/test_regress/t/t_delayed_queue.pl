@@ -0,0 +1,30 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2022 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(simulator => 1);
+
+compile(
+    verilator_flags2 => ["--stats"],
+    threads => $Self->{vltmt} ? 2 : 0,
+    );
+
+# With --threads, the array written from two processes has a queue for each
+if ($Self->{vltmt}) {
+    file_grep($Self->{stats}, qr/Optimizations, Delayed commit queues\s+(\d+)/i, 5);
+} elsif ($Self->{vlt}) {
+    file_grep($Self->{stats}, qr/Optimizations, Delayed commit queues\s+(\d+)/i, 4);
+}
+
+execute(
+    check_finished => 1,
+    );
+
+ok(1);
+1;
@@ -0,0 +1,99 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2022 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+
+   localparam SIZE = 1024;
+
+   // Cleared in a loop too large to unroll, then written
+   int ram [SIZE];
+   // Wide elements, written in a loop too large to unroll
+   logic [95:0] wide [SIZE];
+   // Written from many assignments
+   logic [7:0] regs [16];
+   // Written in loops from two processes
+   int shared [SIZE];
+
+   always @(posedge clk) begin
+      if (cyc == 1) begin
+         for (int i = 0; i < SIZE; i++) begin
+            ram[i] <= i;
+            wide[i] <= {32'(i), 32'(~i), 32'(i * 3)};
+         end
+         ram[5] <= 55;  // Later write to the same element wins
+      end
+      else if (cyc == 2) begin
+         ram[7] <= ram[5];
+         wide[9] <= '1;
+      end
+   end
+
+   always @(posedge clk) begin
+      if (cyc == 1) begin
+         regs[0] <= 8'h10;
+         regs[1] <= 8'h11;
+         regs[2] <= 8'h12;
+         regs[3] <= 8'h13;
+         regs[4] <= 8'h14;
+         regs[5] <= 8'h15;
+         regs[6] <= 8'h16;
+         regs[7] <= 8'h17;
+      end
+      else if (cyc == 2) begin
+         regs[cyc[3:0]] <= regs[0] + regs[1];
+         regs[0] <= regs[2];
+      end
+   end
+
+   always @(posedge clk) begin
+      if (cyc == 1) begin
+         for (int i = 0; i < SIZE / 2; i++) shared[i] <= i + 1;
+      end
+   end
+   always @(posedge clk) begin
+      if (cyc == 1) begin
+         for (int i = SIZE / 2; i < SIZE; i++) shared[i] <= i + 2;
+      end
+      else if (cyc == 2) begin
+         shared[0] <= shared[SIZE - 1];
+      end
+   end
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc == 2) begin
+         if (ram[0] != 0) $stop;
+         if (ram[5] != 55) $stop;
+         if (ram[SIZE - 1] != SIZE - 1) $stop;
+         if (wide[3] != {32'd3, ~32'd3, 32'd9}) $stop;
+         if (regs[0] != 8'h10) $stop;
+         if (regs[7] != 8'h17) $stop;
+         if (shared[0] != 1) $stop;
+         if (shared[SIZE / 2 - 1] != SIZE / 2) $stop;
+         if (shared[SIZE / 2] != SIZE / 2 + 2) $stop;
+      end
+      else if (cyc == 3) begin
+         if (ram[7] != 55) $stop;
+         if (ram[6] != 6) $stop;
+         if (wide[9] != '1) $stop;
+         if (wide[8] != {32'd8, ~32'd8, 32'd24}) $stop;
+         if (regs[0] != 8'h12) $stop;
+         if (regs[2] != 8'h21) $stop;
+         if (regs[3] != 8'h13) $stop;
+         if (shared[0] != SIZE + 1) $stop;
+         if (shared[1] != 2) $stop;
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+endmodule
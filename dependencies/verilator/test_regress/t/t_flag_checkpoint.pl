@@ -0,0 +1,60 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2022 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+# The submodule is found on the second -y path, so looked for on the first
+mkdir "$Self->{obj_dir}/y_a";
+mkdir "$Self->{obj_dir}/y_b";
+my $sub = ("module t_flag_checkpoint_sub (input [31:0] sum, input [31:0] cyc,"
+           . " output [31:0] next);\n"
+           . "   assign next = sum + cyc;\n"
+           . "endmodule\n");
+write_wholefile("$Self->{obj_dir}/y_b/t_flag_checkpoint_sub.v", $sub);
+
+my @flags = ("--checkpoint-dir $Self->{obj_dir}/checkpoint", "--debugi-V3Checkpoint 1",
+             "-y $Self->{obj_dir}/y_a", "-y $Self->{obj_dir}/y_b");
+
+compile(
+    verilator_flags2 => [@flags],
+    );
+
+file_grep("$Self->{obj_dir}/vlt_compile.log", qr/No checkpoint at/);
+
+# Same frontend, different backend options: served by the checkpoint
+compile(
+    verilator_flags2 => [@flags, "-fno-gate", "--stats"],
+    );
+
+file_grep("$Self->{obj_dir}/vlt_compile.log", qr/Resuming from checkpoint/);
+file_grep_not("$Self->{obj_dir}/$Self->{vm_prefix}__stats.txt",
+              qr/Optimizations, Gate sigs deleted/);
+
+# A new file that would be found first is noticed, though nothing read changed
+write_wholefile("$Self->{obj_dir}/y_a/t_flag_checkpoint_sub.v", $sub);
+compile(
+    verilator_flags2 => [@flags, "-fno-gate"],
+    );
+
+file_grep("$Self->{obj_dir}/vlt_compile.log", qr/Not resuming from checkpoint .*y_a.* was added/);
+
+# V3Const also runs during elaboration, so this needs a new checkpoint
+compile(
+    verilator_flags2 => [@flags, "-fno-const-bit-op-tree"],
+    );
+
+file_grep("$Self->{obj_dir}/vlt_compile.log", qr/No checkpoint at/);
+
+execute(
+    check_finished => 1,
+    );
+
+ok(1);
+1;
@@ -0,0 +1,28 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2022 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   reg [31:0] sum = 0;
+   wire [31:0] next;
+
+   t_flag_checkpoint_sub sub (.sum(sum), .cyc(cyc), .next(next));
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      sum <= next;
+      if (cyc == 9) begin
+         if (sum != 32'd36) $stop;
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
@@ -0,0 +1,39 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2022 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+compile(
+    verilator_flags2 => ["--eval-patterns", "t/t_flag_eval_patterns.dat"],
+    verilator_make_gmake => 0,
+    make_top_shell => 0,
+    make_main => 0,
+    );
+
+my $log = "$Self->{obj_dir}/vlt_compile.log";
+file_grep($log, qr/^\+\+PAT\+\+ 0 a 1001 #$/m);
+file_grep($log, qr/^\+\+VAL\+\+ 0 y 01100 #$/m);
+file_grep($log, qr/^\+\+VAL\+\+ 0 z 1001 #$/m);
+file_grep($log, qr/^\+\+RPT\+\+ 0 1001 0011 1 01100 y$/m);
+file_grep($log, qr/^\+\+VAL\+\+ 0 syn 01100 #$/m);
+file_grep($log, qr/^\+\+RPT\+\+ 0 1001 0011 1 01100 syn$/m);
+# '~' fills with ones, and undefined bits of the reference are masked
+file_grep($log, qr/^\+\+VAL\+\+ 1 y 1x1x0 #$/m);
+file_grep($log, qr/^\+\+VAL\+\+ 1 z x1x1 #$/m);
+file_grep($log, qr/^\+\+RPT\+\+ 1 1111 1111 1 1x1x0 syn$/m);
+file_grep($log, qr/^\+\+VAL\+\+ 2 y 01111 #$/m);
+file_grep($log, qr/^\+\+VAL\+\+ 2 z 0110 #$/m);
+file_grep($log, qr/^\+\+OK\+\+$/m);
+
+# Nothing to compile
+error("Model written with --eval-patterns") if -e "$Self->{obj_dir}/$Self->{VM_PREFIX}.cpp";
+
+ok(1);
+1;
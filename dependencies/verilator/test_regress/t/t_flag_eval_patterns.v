@@ -0,0 +1,28 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2022 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Outputs
+   y, z, syn_y,
+   // Inputs
+   a, b, s
+   );
+   input [3:0] a;
+   input [3:0] b;
+   input       s;
+   output [4:0] y;
+   output reg [3:0] z;
+   output [4:0] syn_y;  // Reported as "syn", as in vlog-hammer's testbench
+
+   wire [4:0]  sum = a + b;
+   assign y = s ? sum : {1'b0, a ^ b};
+   assign syn_y = y;
+
+   always_comb begin
+      z = a;
+      z[0] = b[0];
+   end
+endmodule
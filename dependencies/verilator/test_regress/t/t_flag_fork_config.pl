@@ -0,0 +1,36 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2022 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+compile(
+    verilator_flags2 => ["--stats",
+                         "--fork-config t/t_flag_fork_config_a.vc",
+                         "--fork-config t/t_flag_fork_config_b.vc"],
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+# Each configuration verilated into its own directory, with its own options
+foreach my $cfg ("t_flag_fork_config_a", "t_flag_fork_config_b") {
+    my $dir = "$Self->{obj_dir}/$cfg";
+    -r "$dir/$Self->{vm_prefix}.mk" or error("Missing $dir/$Self->{vm_prefix}.mk");
+    -r "$dir/$Self->{vm_prefix}__stats.txt" or error("Missing $dir/$Self->{vm_prefix}__stats.txt");
+}
+# Only the -fno-gate configuration skipped V3Gate
+file_grep_not("$Self->{obj_dir}/t_flag_fork_config_a/$Self->{vm_prefix}__stats.txt",
+              qr/Optimizations, Gate sigs deleted/);
+file_grep("$Self->{obj_dir}/$Self->{vm_prefix}__stats.txt",
+          qr/Optimizations, Gate sigs deleted/);
+
+ok(1);
+1;
@@ -0,0 +1,33 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2022 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+top_filename("t/t_flag_fork_config.v");
+
+# Configuration files of the same name get numbered directories
+mkdir "$Self->{obj_dir}/a";
+mkdir "$Self->{obj_dir}/b";
+write_wholefile("$Self->{obj_dir}/a/x.vc", "-fno-gate\n");
+write_wholefile("$Self->{obj_dir}/b/x.vc", "--output-split 10\n");
+
+compile(
+    verilator_flags2 => ["--stats",
+                         "--fork-config $Self->{obj_dir}/a/x.vc",
+                         "--fork-config $Self->{obj_dir}/b/x.vc"],
+    );
+
+file_grep_not("$Self->{obj_dir}/x__1/$Self->{vm_prefix}__stats.txt",
+              qr/Optimizations, Gate sigs deleted/);
+file_grep("$Self->{obj_dir}/x__2/$Self->{vm_prefix}__stats.txt",
+          qr/Optimizations, Gate sigs deleted/);
+error("Unnumbered directory written") if -e "$Self->{obj_dir}/x";
+
+ok(1);
+1;
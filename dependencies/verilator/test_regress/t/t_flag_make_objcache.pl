@@ -0,0 +1,41 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2022 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+top_filename("t/t_a1_first_cc.v");
+
+my $cache_dir = "$Self->{obj_dir}/objcache";
+my $objcache = "VERILATOR_OBJCACHE=\"$ENV{VERILATOR_ROOT}/bin/verilator_objcache --debug\"";
+
+compile(
+    verilator_flags2 => ['--trace'],
+    make_flags => "VERILATOR_OBJCACHE_DIR=$cache_dir $objcache",
+    );
+
+file_grep("$Self->{obj_dir}/vlt_gcc.log", qr/verilator_objcache: miss verilated\.o/);
+
+# Rebuild from scratch, now every object comes from the cache
+foreach my $filename (glob("$Self->{obj_dir}/*.o")) {
+    unlink $filename;
+}
+run(logfile => "$Self->{obj_dir}/rebuild.log",
+    cmd => [$ENV{MAKE}, "-C", $Self->{obj_dir},
+            "-f", "$Self->{VM_PREFIX}.mk",
+            "VERILATOR_OBJCACHE_DIR=$cache_dir", $objcache]);
+
+file_grep("$Self->{obj_dir}/rebuild.log", qr/verilator_objcache: hit verilated\.o/);
+file_grep_not("$Self->{obj_dir}/rebuild.log", qr/verilator_objcache: miss/);
+
+execute(
+    check_finished => 1,
+    );
+
+ok(1);
+1;
@@ -0,0 +1,82 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2022 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+use Cwd qw(abs_path);
+use File::Copy;
+
+scenarios(vlt => 1);
+top_filename("t/t_a1_first_cc.v");
+
+if (!`which objcopy 2>/dev/null`) {
+    skip("No objcopy installed\n");
+} else {
+    my $obj_dir = abs_path($Self->{obj_dir});
+    my $cache_dir = "$obj_dir/objcache";
+    my $objcache = "VERILATOR_OBJCACHE=\"$ENV{VERILATOR_ROOT}/bin/verilator_objcache --debug\"";
+
+    # Stand-in for wllvm++: compile, then write a bitcode file next to the
+    # object and name it in the object's .llvm_bc section
+    my $wrapper = "$obj_dir/fake_wllvm";
+    write_wholefile($wrapper, <<'EOF');
+#!/bin/sh
+${CXX_REAL:-g++} "$@" || exit $?
+out=""
+prev=""
+for arg in "$@"; do
+    if [ "$prev" = "-o" ]; then out=$arg; fi
+    prev=$arg
+done
+case "$out" in
+    *.o) ;;
+    *) exit 0 ;;
+esac
+dir=$(cd "$(dirname "$out")" && pwd)
+bc="$dir/.$(basename "$out").bc"
+echo "bitcode for $(basename "$out")" > "$bc"
+echo "$bc" > "$out.section"
+objcopy --add-section .llvm_bc="$out.section" "$out" || exit $?
+rm -f "$out.section"
+EOF
+    chmod(0755, $wrapper);
+
+    compile(
+        verilator_flags2 => ['--trace'],
+        make_flags => "CXX=$wrapper VERILATOR_OBJCACHE_DIR=$cache_dir $objcache",
+        );
+
+    file_grep("$Self->{obj_dir}/vlt_gcc.log", qr/verilator_objcache: miss verilated\.o/);
+    file_grep("$obj_dir/.verilated.o.bc", qr/^bitcode for verilated\.o$/);
+
+    # Build the same model in a second directory, objects come from the cache
+    my $rebuild_dir = "$obj_dir/rebuild";
+    mkdir $rebuild_dir;
+    foreach my $filename (glob("$obj_dir/*.cpp $obj_dir/*.h $obj_dir/*.mk")) {
+        copy($filename, $rebuild_dir) or error("copy $filename: $!");
+    }
+    run(logfile => "$Self->{obj_dir}/rebuild.log",
+        cmd => [$ENV{MAKE}, "-C", $rebuild_dir,
+                "-f", "$Self->{VM_PREFIX}.mk",
+                "CXX=$wrapper", "VERILATOR_OBJCACHE_DIR=$cache_dir", $objcache,
+                "verilated.o", "$Self->{VM_PREFIX}__ALL.a"]);
+
+    file_grep("$Self->{obj_dir}/rebuild.log", qr/verilator_objcache: hit verilated\.o/);
+    file_grep_not("$Self->{obj_dir}/rebuild.log", qr/verilator_objcache: miss/);
+
+    # The restored object's .llvm_bc section names the restored bitcode file,
+    # not the one in the directory the entry was stored from
+    file_grep("$rebuild_dir/.verilated.o.bc", qr/^bitcode for verilated\.o$/);
+    run(logfile => "$Self->{obj_dir}/objcopy.log",
+        cmd => ["objcopy", "--dump-section", ".llvm_bc=$rebuild_dir/llvm_bc",
+                "$rebuild_dir/verilated.o", "/dev/null"]);
+    file_grep("$rebuild_dir/llvm_bc", qr/^\Q$rebuild_dir\/.verilated.o.bc\E$/);
+}
+
+ok(1);
+1;
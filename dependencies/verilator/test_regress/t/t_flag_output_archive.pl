@@ -0,0 +1,39 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2022 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+top_filename("t/t_a1_first_cc.v");
+
+my $archive = "$Self->{obj_dir}/output.tar";
+my $cpp = "$Self->{obj_dir}/$Self->{VM_PREFIX}.cpp";
+
+compile(
+    verilator_flags2 => ["--output-archive", $archive],
+    verilator_make_gmake => 0,
+    make_top_shell => 0,
+    make_main => 0,
+    );
+
+error("Generated file written to disk: $cpp") if -e $cpp;
+
+run(logfile => "$Self->{obj_dir}/tar_list.log",
+    cmd => ["tar", "-tf", $archive]);
+
+file_grep("$Self->{obj_dir}/tar_list.log", qr/^\Q$cpp\E$/m);
+file_grep("$Self->{obj_dir}/tar_list.log", qr/^\Q$Self->{obj_dir}\/$Self->{VM_PREFIX}.mk\E$/m);
+file_grep("$Self->{obj_dir}/tar_list.log", qr/^\Q$Self->{obj_dir}\/$Self->{VM_PREFIX}__ver.d\E$/m);
+file_grep_not("$Self->{obj_dir}/tar_list.log", qr/__verFiles\.dat/);
+
+# Extracting recreates the files as they would have been written
+run(cmd => ["tar", "-xf", $archive]);
+file_grep($cpp, qr/Verilated/);
+
+ok(1);
+1;
@@ -0,0 +1,57 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2022 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt_all => 1);
+top_filename("t/t_flag_csplit.v");
+
+while (1) {
+    if (make_version() < 4.1) {
+        skip("Test requires GNU Make version >= 4.1");
+        last;
+    }
+
+    compile(
+        v_flags2 => ["--pch --output-split 1 --exe ../$Self->{main_filename}"],
+        verilator_make_gmake => 0,
+        );
+
+    # As t_flag_csplit, use the rules in verilated.mk rather than the driver's
+    run(logfile => "$Self->{obj_dir}/vlt_gcc.log",
+        tee => $self->{verbose},
+        cmd=>[$ENV{MAKE},
+              "-C " . $Self->{obj_dir},
+              "-f $Self->{VM_PREFIX}.mk",
+              "-j 4",
+              "VM_PREFIX=$Self->{VM_PREFIX}",
+              "TEST_OBJ_DIR=$Self->{obj_dir}",
+              "CPPFLAGS_DRIVER=-D".uc($Self->{name}),
+              ($opt_verbose ? "CPPFLAGS_DRIVER2=-DTEST_VERBOSE=1" : ""),
+              "OPT_FAST=-O2",
+              "OPT_SLOW=-O0",
+              "OPT_GLOBAL=-Os",
+        ]);
+
+    execute(
+        check_finished => 1,
+        );
+
+    file_grep("$Self->{obj_dir}/$Self->{VM_PREFIX}_classes.mk", qr/VM_PCH\s*=\s*1/);
+    file_grep("$Self->{obj_dir}/$Self->{VM_PREFIX}__pch.h", qr/#include "$Self->{VM_PREFIX}__Syms.h"/);
+    # Both optimization levels have a precompiled header, used by the model sources
+    foreach my $level ("fast", "slow") {
+        my $gch = "$Self->{obj_dir}/$Self->{VM_PREFIX}__pch.h.$level.gch";
+        -r $gch or error("Missing precompiled header $gch");
+        file_grep("$Self->{obj_dir}/vlt_gcc.log", qr/-include\S* $Self->{VM_PREFIX}__pch\.h\.$level/);
+    }
+
+    ok(1);
+    last;
+}
+1;
@@ -0,0 +1,67 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2022 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+compile(
+    verilator_flags2 => ["--smt2"],
+    verilator_make_gmake => 0,
+    make_top_shell => 0,
+    make_main => 0,
+    );
+
+my $smt2 = "$Self->{obj_dir}/$Self->{VM_PREFIX}.smt2";
+file_grep($smt2, qr/^\(set-logic QF_BV\)$/m);
+# Clocks are high, not declared
+file_grep_not($smt2, qr/declare-fun clk /);
+file_grep($smt2, qr/^\(declare-fun en \(\) \(_ BitVec 1\)\)$/m);
+file_grep($smt2, qr/^\(declare-fun d \(\) \(_ BitVec 4\)\)$/m);
+file_grep($smt2, qr/^\(declare-fun \w*cnt \(\) \(_ BitVec 4\)\)$/m);
+# The enable selects the next count
+file_grep($smt2, qr/\(ite /);
+file_grep($smt2, qr/^\(define-fun \w*cnt__next \(\) \(_ BitVec 4\) /m);
+file_grep($smt2, qr/^\(define-fun q__next \(\) \(_ BitVec 4\) /m);
+file_grep($smt2, qr/^\(define-fun wrap__next \(\) \(_ BitVec 1\) /m);
+
+# Nothing to compile
+error("Model written with --smt2") if -e "$Self->{obj_dir}/$Self->{VM_PREFIX}.cpp";
+
+# Prove the relation equals a hand-written one for the design
+my $solver;
+foreach my $try ("z3 -smt2", "boolector --smt2", "cvc5 --lang smt2") {
+    my ($prog) = split(/ /, $try);
+    if (`which $prog 2>/dev/null`) { $solver = $try; last; }
+}
+if (!$solver) {
+    skip("No SMT solver (z3, boolector, cvc5) installed for the semantic check\n");
+} else {
+    my ($cnt) = (file_contents($smt2) =~ /^\(declare-fun (\w*cnt) /m);
+    my $check = "$Self->{obj_dir}/check.smt2";
+    write_wholefile($check, file_contents($smt2) . <<"END");
+
+; Known-good relation
+(define-fun ref_cnt () (_ BitVec 4) (ite (= en #b1) (bvadd $cnt d) $cnt))
+(define-fun ref_wrap () (_ BitVec 1) (ite (= ref_cnt #xf) #b1 #b0))
+; Some state and inputs satisfy the relation
+(check-sat)
+; No state and inputs make it differ from the known-good one
+(assert (or (distinct ${cnt}__next ref_cnt)
+            (distinct q__next ref_cnt)
+            (distinct wrap__next ref_wrap)))
+(check-sat)
+(exit)
+END
+    run(logfile => "$Self->{obj_dir}/solver.log",
+        cmd => ["$solver $check"]);
+    file_grep("$Self->{obj_dir}/solver.log", qr/\Asat\nunsat\n\z/);
+}
+
+ok(1);
+1;
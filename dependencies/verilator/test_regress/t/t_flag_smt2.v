@@ -0,0 +1,28 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2022 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Outputs
+   q, wrap,
+   // Inputs
+   clk, en, d
+   );
+   input clk;
+   input en;
+   input [3:0] d;
+   output [3:0] q;
+   output      wrap;
+
+   reg [3:0]   cnt;
+
+   always @(posedge clk) begin
+      if (en) cnt <= cnt + d;
+   end
+
+   assign q = cnt;
+   assign wrap = cnt == 4'hf;
+
+endmodule
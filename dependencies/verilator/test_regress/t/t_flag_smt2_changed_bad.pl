@@ -0,0 +1,23 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2022 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+lint(
+    verilator_flags2 => ["--smt2"],
+    fails => 1,
+    );
+
+file_grep("$Self->{obj_dir}/vlt_compile.log",
+          qr/%Error-UNSUPPORTED: .*Unsupported: --smt2: Incomplete sensitivity list, sensitive to any change of 'en'/);
+file_grep_not("$Self->{obj_dir}/vlt_compile.log", qr/Generated clock/);
+
+ok(1);
+1;
@@ -0,0 +1,22 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2022 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Outputs
+   q,
+   // Inputs
+   en, d
+   );
+   input en;
+   input [3:0] d;
+   output reg [3:0] q;
+
+   // Missing d, so not combinational
+   always @(en) begin
+      if (en) q = d;
+   end
+
+endmodule
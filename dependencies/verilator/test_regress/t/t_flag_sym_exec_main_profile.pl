@@ -0,0 +1,40 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2022 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+# The generated main needs KLEE to build, so only Verilate
+compile(
+    verilator_flags2 => ['--sym-exec-main --stats -fno-dfg'],
+    verilator_make_gmake => 0,
+    );
+
+# bo is wider than the default --expand-limit, but is still expanded
+file_grep($Self->{stats}, qr/Optimizations, expand limited\s+(\d+)/i, 0);
+file_grep($Self->{stats}, qr/Optimizations, expand wide words\s+[1-9]/i);
+# Passes that are turned off do not report statistics
+file_grep_not($Self->{stats}, qr/Optimizations, Tables created/i);
+file_grep_not($Self->{stats}, qr/Optimizations, MergeCond merges/i);
+file_grep_not($Self->{stats}, qr/Optimizations, Reloops/i);
+
+# Options given on the command line override the profile
+compile(
+    verilator_flags2 => ['--sym-exec-main --stats -fno-dfg',
+                         '--expand-limit 1 -ftable -fmerge-cond -freloop'],
+    verilator_make_gmake => 0,
+    );
+
+file_grep($Self->{stats}, qr/Optimizations, expand limited\s+[1-9]/i);
+file_grep($Self->{stats}, qr/Optimizations, Tables created/i);
+file_grep($Self->{stats}, qr/Optimizations, MergeCond merges/i);
+file_grep($Self->{stats}, qr/Optimizations, Reloops/i);
+
+ok(1);
+1;
@@ -0,0 +1,38 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2022 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Outputs
+   e, bo,
+   // Inputs
+   clk, bi
+   );
+   input clk;
+   input [4095:0] bi;
+   output [4095:0] bo;
+   output reg [7:0] e;
+
+   reg [2:0] cyc;
+
+   initial cyc = 0;
+   always @(posedge clk) cyc <= cyc + 1;
+
+   // Would be a lookup table indexed by (symbolic) cyc
+   always @* begin
+      case (cyc)
+        3'b000: e = 8'd10;
+        3'b001: e = 8'd21;
+        3'b010: e = 8'd32;
+        3'b100: e = 8'd43;
+        3'b101: e = 8'd54;
+        default: e = 8'd99;
+      endcase
+   end
+
+   // Wider than the default --expand-limit, so would be left as a word loop
+   assign bo = ~bi;
+
+endmodule
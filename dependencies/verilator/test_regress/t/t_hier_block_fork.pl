@@ -0,0 +1,45 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2022 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+# stats will be deleted but generation will be skipped if libs of hierarchical blocks exist.
+clean_objs();
+
+scenarios(vlt_all => 1);
+top_filename("t/t_hier_block.v");
+
+compile(
+    v_flags2 => ['t/t_hier_block.cpp'],
+    verilator_flags2 => ['--stats',
+                         '--hierarchical',
+                         '--hierarchical-fork',
+                         '--build-jobs 2',
+                         '--debugi-V3HierBlock 1',
+                         '--Wno-TIMESCALEMOD',
+                         '--CFLAGS', '"-pipe -DCPP_MACRO=cplusplus"'
+    ],
+    threads => $Self->{vltmt} ? 6 : 0
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+file_grep($Self->{obj_dir} . "/Vsub0/sub0.sv", qr/^\s+\/\/\s+timeprecision\s+(\d+)ps;/mi, 1);
+file_grep($Self->{obj_dir} . "/Vsub0/sub0.sv", /^module\s+(\S+)\s+/, "sub0");
+file_grep($Self->{obj_dir} . "/Vsub1/sub1.sv", /^module\s+(\S+)\s+/, "sub1");
+file_grep($Self->{obj_dir} . "/Vsub2/sub2.sv", /^module\s+(\S+)\s+/, "sub2");
+file_grep($Self->{stats}, qr/HierBlock,\s+Hierarchical blocks\s+(\d+)/i, 13);
+file_grep($Self->{run_log_filename}, qr/MACRO:(\S+) is defined/i, "cplusplus");
+# Blocks and the top were Verilated from the parsed design, not by make
+file_grep($Self->{obj_dir} . "/vlt_compile.log", qr/Forked hierarchical Verilation of \S*Vsub0_hierMkArgs\.f/);
+file_grep($Self->{obj_dir} . "/vlt_compile.log", qr/Forked hierarchical Verilation of \S*$Self->{VM_PREFIX}_hierMkArgs\.f/);
+
+ok(1);
+1;
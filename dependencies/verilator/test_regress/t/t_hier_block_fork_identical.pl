@@ -0,0 +1,38 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2022 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+use File::Find;
+
+scenarios(vlt => 1);
+top_filename("t/t_hier_block.v");
+
+# --hierarchical-fork must give the same model as Verilating each block with
+# make; the `timescale and `defines of the design must not reach the wrappers
+my @flags = ("--cc", "--hierarchical", "--Wno-TIMESCALEMOD", "+define+SHOW_TIMESCALE",
+             "--top-module", "t", $Self->{top_filename});
+
+foreach my $flow ("make", "fork") {
+    run(logfile => "$Self->{obj_dir}/$flow.log",
+        cmd => ["perl", "$ENV{VERILATOR_ROOT}/bin/verilator", @flags,
+                ($flow eq "fork" ? "--hierarchical-fork" : ()),
+                "-Mdir", "$Self->{obj_dir}/$flow"],
+        verilator_run => 1);
+}
+
+my @files;
+find(sub { push @files, $File::Find::name if /\.(cpp|h)$/ }, "$Self->{obj_dir}/make");
+error("No model written") if !@files;
+foreach my $filename (sort @files) {
+    (my $other = $filename) =~ s!/make/!/fork/!;
+    files_identical($filename, $other);
+}
+
+ok(1);
+1;
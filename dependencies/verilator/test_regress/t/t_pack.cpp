@@ -0,0 +1,76 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2022 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+#include <verilated.h>
+
+#include "Vpack.h"
+
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+
+// These require the above. Comment prevents clang-format moving them
+#include "TestCheck.h"
+
+int errors = 0;
+
+static void* portp(const VpackModel* modelp, void* instp, const char* name) {
+    for (size_t i = 0; i < modelp->ports; ++i) {
+        if (0 == std::strcmp(modelp->portsp[i].name, name)) {
+            return modelp->portsp[i].datap(instp);
+        }
+    }
+    return nullptr;
+}
+
+int main(int argc, char* argv[]) {
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+
+    TEST_CHECK_EQ(Vpack_count, 2U);
+    TEST_CHECK_EQ(Vpack_find("t_pack_missing") == nullptr, true);
+
+    {
+        const VpackModel* const modelp = Vpack_find("t_pack_add");
+        TEST_CHECK_EQ(modelp != nullptr, true);
+        TEST_CHECK_EQ(modelp->ports, 3U);
+        // In port list order
+        TEST_CHECK_EQ(std::string{modelp->portsp[0].name}, "y");
+        TEST_CHECK_EQ(modelp->portsp[0].width, 5);
+        TEST_CHECK_EQ(modelp->portsp[0].output, true);
+        TEST_CHECK_EQ(modelp->portsp[2].input, true);
+        void* const instp = modelp->construct(contextp.get(), "TOP");
+        *static_cast<CData*>(portp(modelp, instp, "a")) = 9;
+        *static_cast<CData*>(portp(modelp, instp, "b")) = 12;
+        modelp->eval(instp);
+        TEST_CHECK_EQ(*static_cast<CData*>(portp(modelp, instp, "y")), 21);
+        modelp->final(instp);
+        modelp->destroy(instp);
+    }
+    {
+        const VpackModel* const modelp = Vpack_find("t_pack_wide");
+        TEST_CHECK_EQ(modelp != nullptr, true);
+        TEST_CHECK_EQ(modelp->portsp[0].width, 70);
+        void* const instp = modelp->construct(contextp.get(), "TOP");
+        EData* const ap = static_cast<EData*>(portp(modelp, instp, "a"));
+        ap[0] = 0x12345678;
+        ap[1] = 0;
+        ap[2] = 0x3f;
+        modelp->eval(instp);
+        const EData* const yp = static_cast<EData*>(portp(modelp, instp, "y"));
+        TEST_CHECK_HEX_EQ(yp[0], 0xedcba987);
+        TEST_CHECK_HEX_EQ(yp[1], 0xffffffff);
+        TEST_CHECK_HEX_EQ(yp[2] & 0x3f, 0);
+        modelp->final(instp);
+        modelp->destroy(instp);
+    }
+
+    if (errors) return 10;
+    std::cout << "*-* All Finished *-*" << std::endl;
+    return 0;
+}
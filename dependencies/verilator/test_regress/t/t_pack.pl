@@ -0,0 +1,44 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2022 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+my $root = $ENV{VERILATOR_ROOT};
+my $exe = "$Self->{obj_dir}/t_pack";
+
+run(logfile => "$Self->{obj_dir}/pack.log",
+    cmd => ["$root/bin/verilator_pack",
+            "--Mdir", "$Self->{obj_dir}/pack", "--build", "-j", "2",
+            "t/t_pack_add.v", "t/t_pack_wide.v",
+            "--", "-Wall"]);
+
+file_grep("$Self->{obj_dir}/pack.log", qr/verilator_pack: 2 models/);
+file_grep("$Self->{obj_dir}/pack/Vpack.cpp", qr/"t_pack_add"/);
+
+# The runtime is in the library once, not once per model
+run(logfile => "$Self->{obj_dir}/ar.log",
+    cmd => ["ar", "t", "$Self->{obj_dir}/pack/Vpack__ALL.a"]);
+my @runtime = grep { /^verilated\.o$/ } split(/\n/, file_contents("$Self->{obj_dir}/ar.log"));
+error("verilated.o is in the library " . scalar(@runtime) . " times") if scalar(@runtime) != 1;
+
+# Only the library is linked
+run(logfile => "$Self->{obj_dir}/link.log",
+    cmd => ["$ENV{CXX} -std=c++14 -pthread",
+            "-I$root/include -I$root/include/vltstd -I$Self->{obj_dir}/pack -It",
+            "-o $exe t/t_pack.cpp",
+            "$Self->{obj_dir}/pack/Vpack__ALL.a"]);
+
+run(logfile => "$Self->{obj_dir}/vlt_sim.log",
+    cmd => [$exe]);
+
+file_grep("$Self->{obj_dir}/vlt_sim.log", qr/\*-\* All Finished \*-\*/);
+
+ok(1);
+1;
@@ -0,0 +1,17 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2022 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t_pack_add (/*AUTOARG*/
+   // Outputs
+   y,
+   // Inputs
+   a, b
+   );
+   input [3:0] a;
+   input [3:0] b;
+   output [4:0] y;
+   assign y = a + b;
+endmodule
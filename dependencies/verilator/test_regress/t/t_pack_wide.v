@@ -0,0 +1,17 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2022 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+// Same port names as t_pack_add, in a separate model
+module t_pack_wide (/*AUTOARG*/
+   // Outputs
+   y,
+   // Inputs
+   a
+   );
+   input [69:0] a;
+   output [69:0] y;
+   assign y = ~a;
+endmodule
@@ -0,0 +1,36 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2022 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+my $incfile = "$Self->{obj_dir}/t_preproc_cache.vh";
+my @flags = ("--preproc-cache-dir $Self->{obj_dir}/ppcache", "-I$Self->{obj_dir}",
+             "--no-skip-identical", "--debugi-V3PreShell 4");
+
+write_wholefile($incfile, "`define CACHE_VALUE 8'h12\n");
+
+compile(verilator_flags2 => [@flags]);
+file_grep("$Self->{obj_dir}/vlt_compile.log", qr/Stored preprocessor cache/);
+
+compile(verilator_flags2 => [@flags]);
+file_grep("$Self->{obj_dir}/vlt_compile.log", qr/Using preprocessor cache/);
+
+# Changing an included file invalidates the entry
+write_wholefile($incfile, "`define CACHE_VALUE 8'h34\n");
+compile(verilator_flags2 => [@flags]);
+file_grep("$Self->{obj_dir}/vlt_compile.log", qr/Preprocessor cache stale, changed/);
+
+execute(
+    check_finished => 1,
+    );
+file_grep($Self->{run_log_filename}, qr/CACHE_VALUE=34/);
+
+ok(1);
+1;
@@ -0,0 +1,15 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2022 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`include "t_preproc_cache.vh"
+
+module t;
+   initial begin
+      $write("CACHE_VALUE=%x\n", `CACHE_VALUE);
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
@@ -0,0 +1,27 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2022 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`include "t_preproc_jobs.vh"
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   wire [`JOBS_WIDTH-1:0] sub_out;
+   wire [`JOBS_WIDTH-1:0] lib_out;
+
+   sub sub (.out(sub_out));
+   lib lib (.out(lib_out));
+
+   always @ (posedge clk) begin
+      if (sub_out !== 8'h5a) $stop;
+      if (lib_out !== 8'ha5) $stop;
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
@@ -0,0 +1,10 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2022 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`ifndef T_PREPROC_JOBS_VH
+ `define T_PREPROC_JOBS_VH
+ `define JOBS_WIDTH 8
+`endif
@@ -0,0 +1,31 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2022 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+# t_preproc_jobs_define_defs.v is read first, and defines what this file uses
+compile(
+    v_flags2 => ["t/t_preproc_jobs_define_defs.v", "t/t_preproc_jobs_define_pkg.v"],
+    verilator_flags2 => ["--preproc-jobs 4", "--stats"],
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+if ($Self->{vlt_all}) {
+    file_grep($Self->{stats}, qr/Preprocessor, files prepared in parallel\s+3/);
+    # Only this file read a define an earlier file changed
+    file_grep($Self->{stats}, qr/Preprocessor, files prepared in parallel used\s+2/);
+    file_grep($Self->{stats}, qr/Preprocessor, files preprocessed again\s+1/);
+}
+
+ok(1);
+1;
@@ -0,0 +1,24 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2022 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`ifndef PJD_VALUE
+ `error "PJD_VALUE from t_preproc_jobs_define_defs.v not defined"
+`endif
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   wire [`PJD_WIDTH-1:0] value = `PJD_VALUE;
+
+   always @ (posedge clk) begin
+      if (value !== 8'h3c) $stop;
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
@@ -0,0 +1,11 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2022 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+// Reads no define t_preproc_jobs_define_defs.v changes, so its parallel
+// output is used although that file came first
+package pjd_pkg;
+   localparam int PJD_UNUSED = 1;
+endpackage
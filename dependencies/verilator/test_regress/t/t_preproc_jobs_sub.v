@@ -0,0 +1,12 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2022 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+// Guarded, so harmless when an earlier file has included it already
+`include "t_preproc_jobs.vh"
+
+module sub (output wire [`JOBS_WIDTH-1:0] out);
+   assign out = 8'h5a;
+endmodule
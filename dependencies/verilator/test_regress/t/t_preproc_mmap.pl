@@ -0,0 +1,45 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2022 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+top_filename("$Self->{obj_dir}/$Self->{name}.v");
+
+# Large enough that the preprocessor reads it from a memory mapping,
+# with text spanning many lexer buffer refills
+{
+    my $wholefile = "module t;\n";
+    foreach my $i (0 .. 3999) {
+        $wholefile .= "   // Padding line $i to exceed the read() size threshold\n";
+        $wholefile .= "   localparam int P$i = $i;\n" if $i % 100 == 0;
+    }
+    $wholefile .= "   initial begin\n";
+    $wholefile .= "      if (P3900 != 3900) \$stop;\n";
+    $wholefile .= "      \$write(\"*-* All Finished *-*\\n\");\n";
+    $wholefile .= "      \$finish;\n";
+    $wholefile .= "   end\n";
+    $wholefile .= "endmodule\n";
+    write_wholefile($Self->{top_filename}, $wholefile);
+}
+
+compile(
+    verilator_flags2 => ["--stats"],
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+if ($Self->{vlt_all}) {
+    file_grep($Self->{stats}, qr/Input, files memory mapped\s+1/);
+}
+
+ok(1);
+1;
@@ -0,0 +1,37 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2022 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+scenarios(vlt => 1);
+
+top_filename("$Self->{obj_dir}/$Self->{name}.v");
+
+# Source lines for message context are kept as offsets into the file's
+# text, so check a line deep in a large, memory mapped file is shown correctly
+my $lineno;
+{
+    my $wholefile = "module t;\n";
+    foreach my $i (0 .. 3999) {
+        $wholefile .= "   // Padding line $i to exceed the read() size threshold\n";
+    }
+    $wholefile .= "   wire [3:0] w_narrow = 8'hff;  // Context marker\n";
+    $lineno = ($wholefile =~ tr/\n//);
+    $wholefile .= "endmodule\n";
+    write_wholefile($Self->{top_filename}, $wholefile);
+}
+
+lint(
+    fails => 1,
+    );
+
+file_grep("$Self->{obj_dir}/vlt_compile.log",
+          qr/%Warning-WIDTH\w*: \S+:${lineno}:\d+:[^\n]*\n(?:[^\n]*In instance[^\n]*\n)?\s*${lineno} \|    wire \[3:0\] w_narrow = 8'hff;  \/\/ Context marker\n/);
+
+ok(1);
+1;
@@ -0,0 +1,52 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2022 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   reg [63:0] crc = 64'h5aef0c8d_d70a4497;
+
+   wire [7:0] in = crc[7:0];
+
+   // False loop through the bits of a vector
+   // verilator lint_off UNOPTFLAT
+   wire [1:0] chain;
+   // verilator lint_on UNOPTFLAT
+   assign chain[0] = in[0];
+   assign chain[1] = chain[0] ^ in[1];
+
+   // False loop between processes, taking several iterations to settle
+   // verilator lint_off UNOPTFLAT
+   logic [7:0] a;
+   logic [7:0] b;
+   // verilator lint_on UNOPTFLAT
+   always_comb begin
+      a[3:0] = in[7:4];
+      a[7:4] = b[3:0];
+   end
+   always_comb b = a + 8'd1;
+
+   wire [7:0] a_exp = {in[7:4] + 4'd1, in[7:4]};
+
+   always @ (posedge clk) begin
+`ifdef TEST_VERBOSE
+      $write("[%0t] cyc=%0d in=%x chain=%x a=%x b=%x\n", $time, cyc, in, chain, a, b);
+`endif
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63] ^ crc[2] ^ crc[0]};
+      if (chain !== {in[1] ^ in[0], in[0]}) $stop;
+      if (a !== a_exp) $stop;
+      if (b !== a_exp + 8'd1) $stop;
+      if (cyc == 99) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
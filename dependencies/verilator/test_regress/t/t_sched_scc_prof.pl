@@ -0,0 +1,41 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2022 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+# SCC_LOOP records from --scc-iterate --prof-exec, through bin/verilator_gantt
+
+scenarios(vlt_all => 1);
+
+top_filename("t/t_sched_scc.v");
+
+compile(
+    v_flags2 => ["--scc-iterate --prof-exec"],
+    threads => $Self->{vltmt} ? 2 : 0
+    );
+
+execute(
+    all_run_flags => ["+verilator+prof+exec+start+2",
+                      " +verilator+prof+exec+window+20",
+                      " +verilator+prof+exec+file+$Self->{obj_dir}/profile_exec.dat",
+                      ],
+    check_finished => 1,
+    );
+
+file_grep("$Self->{obj_dir}/profile_exec.dat", qr/VLPROFEXEC SCC_LOOP \d+ id \d+ iterations \d+/);
+
+run(cmd => ["$ENV{VERILATOR_ROOT}/bin/verilator_gantt",
+            "--no-vcd $Self->{obj_dir}/profile_exec.dat",
+            "> $Self->{obj_dir}/gantt.log"],
+    );
+
+file_grep("$Self->{obj_dir}/gantt.log", qr/Combinational loop \(SCC\) statistics:/);
+file_grep("$Self->{obj_dir}/gantt.log", qr/scc \d+: evals [1-9]\d*, mean iterations [\d.]+, max iterations [1-9]/);
+
+ok(1);
+1;
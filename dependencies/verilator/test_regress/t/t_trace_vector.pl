@@ -0,0 +1,45 @@
+#!/usr/bin/env perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2022 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+use File::Copy;
+
+scenarios(vlt => 1);
+
+# Reference trace with a change check per array element
+compile(
+    verilator_flags2 => ['--cc --trace -fno-trace-vector'],
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+file_grep_not("$Self->{obj_dir}/V$Self->{name}__Trace__0.cpp", qr/DataArray\(|BitArray\(/);
+File::Copy::copy($Self->trace_filename, "$Self->{obj_dir}/unrolled.vcd");
+
+compile(
+    verilator_flags2 => ['--cc --trace'],
+    );
+
+execute(
+    check_finished => 1,
+    );
+
+foreach my $func ("chgBitArray", "chgCDataArray", "chgSDataArray", "chgIDataArray",
+                  "chgQDataArray", "chgWDataArray") {
+    file_grep("$Self->{obj_dir}/V$Self->{name}__Trace__0.cpp", qr/$func\(/);
+}
+# Short arrays are still unrolled
+file_grep("$Self->{obj_dir}/V$Self->{name}__Trace__0.cpp", qr/bufp->chgCData\(/);
+
+vcd_identical($Self->trace_filename, "$Self->{obj_dir}/unrolled.vcd");
+
+ok(1);
+1;
@@ -0,0 +1,57 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2022 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+
+   // Odd element counts so blocks end part way through arrays, and wide
+   // elements span the 8 word compare blocks
+   reg          a_bit [0:18];
+   reg [6:0]    a_c [0:18];
+   reg [12:0]   a_s [0:18];
+   reg [31:0]   a_i [0:18];
+   reg [47:0]   a_q [0:18];
+   reg [99:0]   a_w [0:18];
+   reg [6:0]    a_short [0:3];
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      // Change a varying subset of elements each cycle, including several per block
+      for (int i = 0; i < 19; ++i) begin
+         if ((i % (cyc % 5 + 1)) == 0) begin
+            a_bit[i] <= ~a_bit[i];
+            a_c[i] <= a_c[i] + 7'(i + 1);
+            a_s[i] <= a_s[i] ^ 13'(cyc * 3 + i);
+            a_i[i] <= a_i[i] + 32'(cyc) * 32'h01010101;
+            a_q[i][47:40] <= 8'(cyc + i);
+            if (i % 2 == 0) a_w[i][99:96] <= 4'(cyc);
+            else a_w[i][35:32] <= 4'(cyc + i);
+         end
+      end
+      a_short[cyc % 4] <= 7'(cyc);
+      if (cyc == 12) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+   initial begin
+      for (int i = 0; i < 19; ++i) begin
+         a_bit[i] = 1'b0;
+         a_c[i] = '0;
+         a_s[i] = '0;
+         a_i[i] = '0;
+         a_q[i] = '0;
+         a_w[i] = '0;
+      end
+      for (int i = 0; i < 4; ++i) a_short[i] = '0;
+   end
+endmodule
@@ -0,0 +1,79 @@
+//
+// DESCRIPTION: Verilator: Verilog Multiple Model Test Module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2022 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+//
+
+#include <verilated.h>
+
+#include <iostream>
+#include <thread>
+
+// These require the above. Comment prevents clang-format moving them
+#include "TestCheck.h"
+
+#include VM_PREFIX_INCLUDE
+
+double sc_time_stamp() { return 0; }
+
+int errors = 0;
+
+void sim(VM_PREFIX* topp) {
+    VerilatedContext* contextp = topp->contextp();
+    // This test created a thread, so need to associate VerilatedContext with it
+    Verilated::threadContextp(contextp);
+
+    // reset
+    topp->clk = 0;
+    topp->rst = 1;
+    topp->eval();
+    contextp->timeInc(1);
+    topp->clk = 1;
+    topp->eval();
+    contextp->timeInc(1);
+    topp->rst = 0;
+    topp->clk = 0;
+    topp->eval();
+
+    // simulate until done
+    while (!topp->done_o) {
+        contextp->timeInc(1);
+        topp->clk = !topp->clk;
+        topp->eval();
+    }
+}
+
+int main(int argc, char** argv, char** env) {
+    // One thread pool for both contexts
+    const std::shared_ptr<VerilatedVirtualBase> poolp = VerilatedContext::newThreadPool(4);
+
+    std::unique_ptr<VerilatedContext> context0p{new VerilatedContext};
+    std::unique_ptr<VerilatedContext> context1p{new VerilatedContext};
+    context0p->threadPool(poolp);
+    context1p->threadPool(poolp);
+    TEST_CHECK_EQ(context0p->threads(), 4);
+    TEST_CHECK_EQ(context1p->threads(), 4);
+
+    std::unique_ptr<VM_PREFIX> top0p{new VM_PREFIX{context0p.get(), "top0"}};
+    std::unique_ptr<VM_PREFIX> top1p{new VM_PREFIX{context1p.get(), "top1"}};
+    TEST_CHECK_EQ(context0p->threadPoolp(), context1p->threadPoolp());
+
+    // Evaluate both models concurrently on the shared pool
+    std::thread t0(sim, top0p.get());
+    std::thread t1(sim, top1p.get());
+    t0.join();
+    t1.join();
+
+    // Same stimulus, so same result
+    TEST_CHECK_EQ(top0p->sum, top1p->sum);
+    TEST_CHECK_EQ(context0p->time(), context1p->time());
+
+    top0p->final();
+    top1p->final();
+
+    if (errors) return 10;
+    std::cout << "*-* All Finished *-*" << std::endl;
+    return 0;
+}
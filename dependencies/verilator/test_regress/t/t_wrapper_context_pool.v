@@ -0,0 +1,42 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// Independent counters, so the model has several mtasks. It is instantiated
+// in two contexts sharing one thread pool, evaluated from concurrent threads.
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2022 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module top
+  (
+   input             clk,
+   input             rst,
+   output bit [31:0] sum,
+   output bit        done_o
+   );
+
+   bit [31:0] cnt [8];
+   int        cyc;
+
+   for (genvar i = 0; i < 8; ++i) begin : gen
+      always @(posedge clk) begin
+         if (rst) cnt[i] <= i;
+         else cnt[i] <= (cnt[i] * 32'd1103515245 + 32'd12345) ^ (cnt[i] >> (i + 1));
+      end
+   end
+
+   always @(posedge clk) begin
+      if (rst) begin
+         cyc <= 0;
+         sum <= 0;
+      end
+      else begin
+         cyc <= cyc + 1;
+         sum <= sum + (cnt[0] ^ cnt[1]) + (cnt[2] ^ cnt[3]) + (cnt[4] ^ cnt[5])
+                + (cnt[6] ^ cnt[7]);
+      end
+   end
+
+   always_comb done_o = cyc >= 1000;
+
+endmodule
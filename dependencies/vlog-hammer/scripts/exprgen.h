@@ -0,0 +1,701 @@
+/*
+ *  VlogHammer -- A Verilog Synthesis Regression Test
+ *
+ *  Copyright (C) 2013  Clifford Wolf <clifford@clifford.at>
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef EXPRGEN_H
+#define EXPRGEN_H
+
+// Random Verilog expression and test module generator used by generate.cc.
+//
+// All text is appended to a caller-supplied std::string and each exprgen has
+// its own random state, so expressions can be streamed straight into a
+// simulator or fuzzer, from as many threads as there are exprgen objects:
+//
+//	exprgen gen;
+//	std::string text;
+//	gen.xorshift32(42);
+//	gen.expression_module(text, "expression_00042");
+//
+// A generator seeded with a test number writes the same module as
+// generate.cc does for that test. Random numbers are drawn in the order the
+// text is written, so the output does not depend on the compiler.
+
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string>
+#include <algorithm>
+
+#define XORSHIFT_SEED 20140925
+
+static const char *arg_types[][3] = {
+	{ "{dir} [3:0] {name}", "{name}", "4" },	// 00
+	{ "{dir} [4:0] {name}", "{name}", "5" },	// 01
+	{ "{dir} [5:0] {name}", "{name}", "6" },	// 02
+	{ "{dir} signed [3:0] {name}", "{name}", "4" },	// 03
+	{ "{dir} signed [4:0] {name}", "{name}", "5" },	// 04
+	{ "{dir} signed [5:0] {name}", "{name}", "6" }	// 05
+};
+
+// See Table 5-1 (page 42) in IEEE Std 1364-2005
+// for a list of all Verilog oprators.
+
+static const char *binary_ops[] = {
+	"+",	// 00
+	"-",	// 01
+	"*",	// 02
+	"/",	// 03
+	"%",	// 04
+	"**",	// 05
+	">",	// 06
+	">=",	// 07
+	"<",	// 08
+	"<=",	// 09
+	"&&",	// 10
+	"||",	// 11
+	"==",	// 12
+	"!=",	// 13
+	"===",	// 14
+	"!==",	// 15
+	"&",	// 16
+	"|",	// 17
+	"^",	// 18
+	"^~",	// 19
+	"<<",	// 20
+	">>",	// 21
+	"<<<",	// 22
+	">>>",	// 23
+};
+
+static const char *unary_ops[] = {
+	"+",	// 00
+	"-",	// 01
+	"!",	// 02
+	"~",	// 03
+	"&",	// 04
+	"~&",	// 05
+	"|",	// 06
+	"~|",	// 07
+	"^",	// 08
+	"~^",	// 09
+};
+
+#define SIZE(_list) int(sizeof(_list) / sizeof(*_list))
+
+static inline void strsubst(std::string &str, const std::string &match, const std::string &replace)
+{
+	size_t pos;
+	while ((pos = str.find(match)) != std::string::npos)
+		str.replace(pos, match.size(), replace);
+}
+
+struct exprgen
+{
+	// Knobs, the defaults are what generate.cc uses
+	int param_budget = 15;		// expression_module(): localparam budget is 1..param_budget
+	int assign_budget = 20;		// expression_module(): assign budget is 1..assign_budget
+	int wideexpr_depth = 5;		// wideexpr_module(): depth is wideexpr_depth + 0..wideexpr_extra-1
+	int wideexpr_extra = 5;
+	int partsel_depth = 4;		// partsel(): no more selects after this nesting depth
+
+	uint32_t x = 314159265 + XORSHIFT_SEED;
+
+	// With a seed, restart the stream from it first
+	uint32_t xorshift32(uint32_t seed = 0)
+	{
+		if (seed) {
+			x = (seed << 16) + XORSHIFT_SEED;
+			for (int i = 0; i < 10; i++)
+				xorshift32();
+		}
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		return x;
+	}
+
+	static void put(std::string &out, int value)
+	{
+		char buffer[16];
+		int n = 0;
+		unsigned v = value < 0 ? -unsigned(value) : value;
+		do {
+			buffer[n++] = '0' + v % 10;
+			v /= 10;
+		} while (v);
+		if (value < 0)
+			buffer[n++] = '-';
+		while (n)
+			out += buffer[--n];
+	}
+
+	void expression(std::string &out, int budget, uint32_t mask = 0, bool avoid_undef = false,
+			bool avoid_signed = false, bool in_param = false);
+	void wideexpr(std::string &out, bool is_signed, int max_depth);
+	void partsel(std::string &out, int max_var, int depth = 0);
+
+	// Complete test modules, as in rtl/expression_*.v, rtl/wideexpr_*.v and rtl/partsel_*.v
+	void expression_module(std::string &out, const char *name);
+	void wideexpr_module(std::string &out, const char *name);
+	void partsel_module(std::string &out, const char *name);
+};
+
+inline void exprgen::expression(std::string &out, int budget, uint32_t mask, bool avoid_undef, bool avoid_signed, bool in_param)
+{
+	bool avoid_mult_div_mod = false;
+	int num_binary_ops = SIZE(binary_ops);
+	int num_unary_ops = SIZE(unary_ops);
+	int num_arg_types = SIZE(arg_types);
+	int num_modes = 10;
+	int i, j, mode;
+	const char *p;
+
+	assert(budget >= 0);
+	if (budget == 0) {
+		if (in_param)
+			goto print_constant;
+		char var_char;
+		int var_index;
+		if (!avoid_undef && (xorshift32() % 256) > (mask >> 24)) {
+			var_char = 'p';
+			var_index = xorshift32() % (3*num_arg_types);
+		} else {
+			var_char = 'a' + (xorshift32() % 2);
+			var_index = xorshift32() % num_arg_types;
+		}
+		if (avoid_signed && (var_index % num_arg_types) >= num_arg_types/2)
+			var_index -= num_arg_types/2;
+		out += var_char;
+		put(out, var_index);
+		return;
+	}
+
+	while ((mask & ~(~0u << num_modes)) == 0)
+		mask = xorshift32() & (in_param ? ~4 : ~0);
+
+	if ((mask & 3) != 0)
+		avoid_mult_div_mod = true;
+
+	do {
+		mode = xorshift32() % num_modes;
+	} while (((1 << mode) & mask) == 0);
+
+	budget--;
+	switch (mode)
+	{
+	case 0:
+		// this mode number is used to determine avoid_mult_div_mod
+		i = 1 + xorshift32() % 3;
+		out += "{";
+		for (j = 0; j < i; j++) {
+			if (j)
+				out += ",";
+			expression(out, budget / i, mask, avoid_undef, avoid_signed, in_param);
+		}
+		out += "}";
+		break;
+	case 1:
+		// this mode number is used to determine avoid_mult_div_mod
+		i = (xorshift32() % 4) + 1;
+		out += "{";
+		put(out, i);
+		out += "{";
+		expression(out, budget / i, mask, avoid_undef, avoid_signed, in_param);
+		out += "}}";
+		break;
+	case 2:
+		// this mode number is masked out if in_param is set during mask generation
+		if (avoid_signed)
+			out += "$unsigned(";
+		else {
+			out += xorshift32() % 3 == 0 ? "$signed" : xorshift32() % 2 == 0 ? "$unsigned" : "";
+			out += "(";
+		}
+		expression(out, budget, mask, avoid_undef, false, in_param);
+		out += ")";
+		break;
+	case 3:
+	case 4:
+	case 5:
+		out += "(";
+		do {
+			p = binary_ops[xorshift32() % num_binary_ops];
+		} while ((avoid_mult_div_mod && (!strcmp(p, "*") || !strcmp(p, "/") || !strcmp(p, "%"))) ||
+				(avoid_undef && (!strcmp(p, "/") || !strcmp(p, "%"))));
+		if (!strcmp(p, "===") || !strcmp(p, "!=="))
+			avoid_undef = true;
+		if (!strcmp(p, "**")) {
+			out += arg_types[xorshift32() % num_arg_types][2];
+			out += "'d2 ";
+			out += p;
+			out += " ";
+			expression(out, budget < 3 ? std::max(budget-1, 0) : 2, mask, avoid_undef, true, in_param);
+		} else
+		if (!strcmp(p, "/") || !strcmp(p, "%")) {
+			expression(out, budget < 3 ? std::max(budget-1, 0) : 2, mask, avoid_undef, avoid_signed, in_param);
+			out += p;
+			expression(out, 0, mask, avoid_undef, avoid_signed, in_param);
+		} else {
+			if (!strcmp(p, "*"))
+				budget = budget < 4 ? budget : 4;
+			expression(out, budget/2, mask, avoid_undef, avoid_signed, in_param);
+			out += p;
+			expression(out, budget/2, mask, avoid_undef, avoid_signed, in_param);
+		}
+		out += ")";
+		break;
+	case 6:
+	case 7:
+		out += "(";
+		out += unary_ops[xorshift32() % num_unary_ops];
+		expression(out, budget, mask, avoid_undef, avoid_signed, in_param);
+		out += ")";
+		break;
+	case 8:
+		out += "(";
+		expression(out, budget / 3, mask, avoid_undef, avoid_signed, in_param);
+		out += "?";
+		expression(out, budget / 3, mask, avoid_undef, avoid_signed, in_param);
+		out += ":";
+		expression(out, budget / 3, mask, avoid_undef, avoid_signed, in_param);
+		out += ")";
+		break;
+	case 9:
+print_constant:
+		out += "(";
+		i = (xorshift32() % 4) + 2;
+		if (xorshift32() % 2 == 0 && !avoid_signed) {
+			out += xorshift32() % 2 == 0 ? "-" : "";
+			put(out, i);
+			out += "'sd";
+			put(out, xorshift32() % (1 << (i-1)));
+		} else {
+			put(out, i);
+			out += "'d";
+			put(out, xorshift32() % (1 << i));
+		}
+		out += ")";
+		break;
+	}
+}
+
+inline void exprgen::wideexpr(std::string &out, bool is_signed, int max_depth)
+{
+	static const char *prefix_ops[] = { "+", "-", "!", "~", "&", "~&", "|", "~|", "^", "~^" };
+	static const char *combine_ops[] = { "+", "-", "&", "|", "^", "^~" };
+	static const char *shift_ops[] = { "<<", "<<<", ">>", ">>>" };
+	static const char *compare_ops[] = { "<", "<=", "==", "!=", ">=", ">" };
+	int mode, k;
+
+	if (max_depth <= 0)
+		mode = xorshift32() % 2;
+	else if (is_signed)
+		mode = xorshift32() % 7;
+	else
+		mode = xorshift32() % 10;
+
+	switch (mode)
+	{
+	/* block 1: terminal nodes */
+	case 0:
+		k = (xorshift32() % 6) + 1;
+		put(out, k);
+		out += is_signed || (xorshift32() % 2 == 0) ? "'sb" : "'b";
+		for (int i = 0; i < k; i++)
+			out += '0' + xorshift32() % 2;
+		break;
+	case 1:
+		out += is_signed || (xorshift32() % 2 == 0) ? 's' : 'u';
+		put(out, xorshift32() % 8);
+		break;
+
+	/* block 2: nodes for signed and unsigned expressions */
+	case 2:
+		out += prefix_ops[xorshift32() % (is_signed ? 2 : SIZE(prefix_ops))];
+		out += "(";
+		wideexpr(out, xorshift32() % 2 == 0, max_depth-1);
+		out += ")";
+		break;
+	case 3:
+		out += "(";
+		wideexpr(out, is_signed, max_depth-1);
+		out += ")";
+		out += combine_ops[xorshift32() % SIZE(combine_ops)];
+		out += "(";
+		wideexpr(out, is_signed, max_depth-1);
+		out += ")";
+		break;
+	case 4:
+		out += "(";
+		wideexpr(out, is_signed, max_depth-1);
+		out += ")";
+		out += shift_ops[xorshift32() % SIZE(shift_ops)];
+		out += "(";
+		wideexpr(out, xorshift32() % 2 == 0, max_depth-1);
+		out += ")";
+		break;
+	case 5:
+		out += "(ctrl[";
+		put(out, xorshift32() % 8);
+		out += "]?";
+		wideexpr(out, is_signed, max_depth-1);
+		out += ":";
+		wideexpr(out, is_signed, max_depth-1);
+		out += ")";
+		break;
+	case 6:
+		out += is_signed || (xorshift32() % 2 == 0) ? "$signed(" : "$unsigned(";
+		is_signed = xorshift32() % 2 == 0;
+		wideexpr(out, is_signed, max_depth-1);
+		out += ")";
+		break;
+
+	/* block 3: nodes for unsigned expressions */
+	case 7:
+		is_signed = xorshift32() % 2 == 0;
+		out += "(";
+		wideexpr(out, is_signed, max_depth-1);
+		out += ")";
+		out += compare_ops[xorshift32() % SIZE(compare_ops)];
+		out += "(";
+		wideexpr(out, is_signed, max_depth-1);
+		out += ")";
+		break;
+	case 8:
+		k = (xorshift32() % 4) + 1;
+		for (int i = 0; i < k; i++) {
+			out += i == 0 ? "{" : ",";
+			is_signed = xorshift32() % 2 == 0;
+			wideexpr(out, is_signed, max_depth-1);
+		}
+		out += "}";
+		break;
+	case 9:
+		k = (xorshift32() % 4) + 1;
+		out += "{";
+		put(out, k);
+		out += "{";
+		is_signed = xorshift32() % 2 == 0;
+		wideexpr(out, is_signed, max_depth-1);
+		out += "}}";
+		break;
+
+	default:
+		abort();
+	}
+}
+
+inline void exprgen::partsel(std::string &out, int max_var, int depth)
+{
+	std::string var_name;
+	if (xorshift32() % 2) {
+		var_name = "x";
+		put(var_name, xorshift32() % max_var);
+	} else {
+		var_name = "p";
+		put(var_name, xorshift32() % 4);
+	}
+
+	switch (xorshift32() % (depth > partsel_depth ? 5 : 10))
+	{
+	case 0:
+		out += var_name;
+		break;
+	case 1:
+		out += var_name;
+		if (xorshift32() % 2) {
+			out += "[";
+			put(out, 8 + xorshift32() % 16);
+			out += "]";
+		} else {
+			out += "[";
+			put(out, 4 + xorshift32() % 16);
+			out += " + s";
+			put(out, xorshift32() % 4);
+			out += "]";
+		}
+		break;
+	case 2:
+		out += var_name;
+		out += "[";
+		put(out, xorshift32() % 32);
+		out += " + s";
+		put(out, xorshift32() % 4);
+		out += " ";
+		out += "+-"[xorshift32() % 2];
+		out += ": ";
+		put(out, xorshift32() % 8 + 1);
+		out += "]";
+		break;
+	case 3:
+		// avoid constant out-of-bounds part select: most tools will produce an error
+		out += var_name;
+		if (xorshift32() % 2) {
+			out += "[";
+			put(out, 8 + xorshift32() % 12);
+			out += " +: ";
+		} else {
+			out += "[";
+			put(out, 12 + xorshift32() % 12);
+			out += " -: ";
+		}
+		put(out, 1 + xorshift32() % 4);
+		out += "]";
+		break;
+	case 4:
+	case 5:
+	case 6:
+		out += "(";
+		partsel(out, max_var, depth+1);
+		out += " ";
+		out += "+-|&^"[xorshift32() % 5];
+		out += " ";
+		partsel(out, max_var, depth+1);
+		out += ")";
+		break;
+	case 7:
+		out += "{";
+		partsel(out, max_var, depth+1);
+		out += ", ";
+		partsel(out, max_var, depth+1);
+		out += "}";
+		break;
+	case 8:
+		out += "{2{";
+		partsel(out, max_var, depth+1);
+		out += "}}";
+		break;
+	case 9:
+		out += "(";
+		for (int i = 0; i < 3; i++) {
+			if (i) {
+				out += xorshift32() % 2 ? " ||" : " &&";
+				out += " ";
+			}
+			out += xorshift32() % 2 ? "!" : "";
+			out += "ctrl[";
+			put(out, xorshift32() % 4);
+			out += "]";
+		}
+		out += " ? ";
+		partsel(out, max_var, depth+1);
+		out += " : ";
+		partsel(out, max_var, depth+1);
+		out += ")";
+		break;
+	default:
+		abort();
+	}
+}
+
+inline void exprgen::expression_module(std::string &out, const char *name)
+{
+	out += "module ";
+	out += name;
+	out += "(";
+
+	for (char var = 'a'; var <= 'b'; var++)
+	for (int j = 0; j < SIZE(arg_types); j++) {
+		out += var;
+		put(out, j);
+		out += ", ";
+	}
+	out += "y);\n";
+
+	for (char var = 'a'; var <= 'y'; var++) {
+		for (int j = 0; j < SIZE(arg_types)*(var == 'y' ? 3 : 1); j++) {
+			std::string decl = arg_types[j % SIZE(arg_types)][0];
+			strsubst(decl, "{dir}", var == 'y' ? "wire" : "input");
+			std::string var_name(1, var);
+			put(var_name, j);
+			strsubst(decl, "{name}", var_name);
+			out += "  " + decl + ";\n";
+		}
+		if (var == 'b')
+			var = 'x';
+		out += "\n";
+	}
+
+	int total_y_size = 0;
+	for (int j = 0; j < SIZE(arg_types)*3; j++)
+		total_y_size += atoi(arg_types[j % SIZE(arg_types)][2]);
+	out += "  output [";
+	put(out, total_y_size-1);
+	out += ":0] y;\n";
+
+	out += "  assign y = {";
+	for (int j = 0; j < SIZE(arg_types)*3; j++) {
+		out += j ? ",y" : "y";
+		put(out, j);
+	}
+	out += "};\n";
+	out += "\n";
+
+	for (int j = 0; j < SIZE(arg_types)*3; j++) {
+		std::string decl = arg_types[j % SIZE(arg_types)][0];
+		strsubst(decl, "{dir}", "localparam");
+		std::string param_name = "p";
+		put(param_name, j);
+		strsubst(decl, "{name}", param_name);
+		out += "  " + decl + " = ";
+		expression(out, 1 + xorshift32() % param_budget, 0, false, false, true);
+		out += ";\n";
+	}
+	out += "\n";
+
+	for (int j = 0; j < SIZE(arg_types)*3; j++) {
+		out += "  assign y";
+		put(out, j);
+		out += " = ";
+		expression(out, 1 + xorshift32() % assign_budget, 0, false, false, false);
+		out += ";\n";
+	}
+
+	out += "endmodule\n";
+}
+
+inline void exprgen::wideexpr_module(std::string &out, const char *name)
+{
+	out += "module ";
+	out += name;
+	out += "(ctrl, ";
+
+	for (int i = 0; i < 2; i++)
+	for (int j = 0; j < 8; j++) {
+		out += "us"[i];
+		put(out, j);
+		out += ", ";
+	}
+	out += "y);\n";
+
+	out += "  input [7:0] ctrl;\n";
+	for (int i = 0; i < 2; i++)
+	for (int j = 0; j < 8; j++) {
+		out += i ? "  input signed [" : "  input [";
+		put(out, j);
+		out += ":0] ";
+		out += "us"[i];
+		put(out, j);
+		out += ";\n";
+	}
+
+	out += "  output [127:0] y;\n";
+
+	for (int j = 0; j < 8; j++) {
+		out += "  wire [15:0] y";
+		put(out, j);
+		out += ";\n";
+	}
+
+	out += "  assign y = {";
+	for (int j = 0; j < 8; j++) {
+		out += j ? ",y" : "y";
+		put(out, j);
+	}
+	out += "};\n";
+
+	for (int j = 0; j < 8; j++) {
+		bool is_signed = xorshift32() % 2 == 0;
+		out += "  assign y";
+		put(out, j);
+		out += " = ";
+		wideexpr(out, is_signed, wideexpr_depth + (xorshift32() % wideexpr_extra));
+		out += ";\n";
+	}
+
+	out += "endmodule\n";
+}
+
+inline void exprgen::partsel_module(std::string &out, const char *name)
+{
+	out += "module ";
+	out += name;
+	out += "(ctrl, s0, s1, s2, s3, ";
+
+	for (int i = 0; i < 4; i++) {
+		out += "x";
+		put(out, i);
+		out += ", ";
+	}
+	out += "y);\n";
+
+	out += "  input [3:0] ctrl;\n";
+	out += "  input [2:0] s0;\n";
+	out += "  input [2:0] s1;\n";
+	out += "  input [2:0] s2;\n";
+	out += "  input [2:0] s3;\n";
+
+	for (int i = 0; i < 4; i++) {
+		out += xorshift32() % 2 ? "  input signed [31:0] x" : "  input [31:0] x";
+		put(out, i);
+		out += ";\n";
+	}
+
+	for (int i = 4; i < 16; i++) {
+		bool ascending = xorshift32() % 2;
+		out += xorshift32() % 2 ? "  wire signed [" : "  wire [";
+		int msb = xorshift32() % 8, lsb = xorshift32() % 8;
+		put(out, ascending ? msb : 31 - msb);
+		out += ":";
+		put(out, ascending ? 31 - lsb : lsb);
+		out += "] x";
+		put(out, i);
+		out += ";\n";
+	}
+
+	out += "  output [127:0] y;\n";
+	for (int i = 0; i < 4; i++) {
+		out += xorshift32() % 2 ? "  wire signed [31:0] y" : "  wire [31:0] y";
+		put(out, i);
+		out += ";\n";
+	}
+
+	out += "  assign y = {";
+	for (int i = 0; i < 4; i++) {
+		out += i ? ",y" : "y";
+		put(out, i);
+	}
+	out += "};\n";
+
+	for (int i = 0; i < 4; i++) {
+		bool ascending = xorshift32() % 2;
+		out += xorshift32() % 2 ? "  localparam signed [" : "  localparam [";
+		int msb = xorshift32() % 8, lsb = xorshift32() % 8;
+		put(out, ascending ? msb : 31 - msb);
+		out += ":";
+		put(out, ascending ? 31 - lsb : lsb);
+		out += "] p";
+		put(out, i);
+		out += " = ";
+		put(out, xorshift32() % 1000000000);
+		out += ";\n";
+	}
+
+	for (int i = 4; i < 20; i++) {
+		out += "  assign ";
+		out += i < 16 ? 'x' : 'y';
+		put(out, i < 16 ? i : i - 16);
+		out += " = ";
+		partsel(out, i < 16 ? i : 16, 0);
+		out += ";\n";
+	}
+
+	out += "endmodule\n";
+}
+
+#endif
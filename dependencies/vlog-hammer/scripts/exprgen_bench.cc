@@ -0,0 +1,80 @@
+/*
+ *  VlogHammer -- A Verilog Synthesis Regression Test
+ *
+ *  Copyright (C) 2013  Clifford Wolf <clifford@clifford.at>
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+// Measure how fast exprgen.h generates expressions and test modules
+//
+// Usage: exprgen_bench [<count>]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+#include "exprgen.h"
+
+template <typename F>
+void bench(const char *name, int count, F generate)
+{
+	std::string text;
+	size_t bytes = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < count; i++) {
+		text.clear();
+		generate(text, i);
+		bytes += text.size();
+	}
+	double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	printf("%-18s %9d in %7.3fs: %11.0f/s %8.1f MB/s %6.1f bytes avg\n", name, count, secs,
+			count / secs, bytes / secs / 1e6, double(bytes) / count);
+}
+
+int main(int argc, char **argv)
+{
+	int count = argc > 1 ? atoi(argv[1]) : 1000000;
+	exprgen gen;
+
+	bench("expression", count, [&](std::string &text, int i) {
+		gen.xorshift32(i+1);
+		gen.expression(text, 1 + gen.xorshift32() % gen.assign_budget);
+	});
+	bench("wideexpr", count, [&](std::string &text, int i) {
+		gen.xorshift32(i+1);
+		gen.wideexpr(text, gen.xorshift32() % 2 == 0, gen.wideexpr_depth + gen.xorshift32() % gen.wideexpr_extra);
+	});
+	bench("partsel", count, [&](std::string &text, int i) {
+		gen.xorshift32(i+1);
+		gen.partsel(text, 16);
+	});
+
+	count = std::max(count / 100, 1);
+	bench("expression_module", count, [&](std::string &text, int i) {
+		gen.xorshift32(i+1);
+		gen.expression_module(text, "expression");
+	});
+	bench("wideexpr_module", count, [&](std::string &text, int i) {
+		gen.xorshift32(i+1);
+		gen.wideexpr_module(text, "wideexpr");
+	});
+	bench("partsel_module", count, [&](std::string &text, int i) {
+		gen.xorshift32(i+1);
+		gen.partsel_module(text, "partsel");
+	});
+
+	return 0;
+}
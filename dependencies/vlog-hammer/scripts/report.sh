@@ -333,12 +333,25 @@ if [[ " ${SIM_LIST} " == *" verilator "* ]]; then
 			undef_ref=$( grep '^++VAL++ [0-9]\+ rtl ' $f | awk '{ printf("%s%s", NR == 1 ? "" : ",", $4); }' )
 			break
 		done
-		bash ../../scripts/verilator_tb.sh ${job} $( echo rtl ${SYN_LIST} | tr ' ' , ) $( echo $inputs | tr -d ' ' ) \
-				$( echo $bits\'b0 ~$bits\'b0 $( sort -u fail_patterns.txt | sed "s/^/$bits'b/;" ) $extra_patterns | tr ' ' ',' ) $undef_ref > sim_verilator.cc
+		patterns=$( echo $bits\'b0 ~$bits\'b0 $( sort -u fail_patterns.txt | sed "s/^/$bits'b/;" ) $extra_patterns | tr ' ' ',' )
+		sim_args=""
+		if [ "${VERILATOR_TB}" = bin ]; then
+			bash ../../scripts/verilator_tb_bin.sh ${job} $( echo rtl ${SYN_LIST} | tr ' ' , ) $( echo $inputs | tr -d ' ' ) > sim_verilator.cc
+			python3 ../../scripts/verilator_tb_pack.py patterns sim_verilator.pat $bits $patterns
+			sim_args="-p sim_verilator.pat -o sim_verilator.res -t"
+			for f in sim_yosim.log sim_modelsim.log sim_icarus.log; do
+				test -f $f || continue
+				python3 ../../scripts/verilator_tb_pack.py reference sim_verilator.ref $f rtl && sim_args="$sim_args -r sim_verilator.ref"
+				break
+			done
+		else
+			bash ../../scripts/verilator_tb.sh ${job} $( echo rtl ${SYN_LIST} | tr ' ' , ) $( echo $inputs | tr -d ' ' ) \
+					$patterns $undef_ref > sim_verilator.cc
+		fi
 		if ! make -C obj_dir -f Vtestbench.mk || ! g++ -I "$( grep 'VERILATOR_ROOT *=' obj_dir/Vtestbench.mk | sed 's,.*= *,,' )/include" -o sim_verilator sim_verilator.cc obj_dir/Vtestbench__ALL.a; then
 			echo -n > sim_verilator.log
 		else
-			./sim_verilator > sim_verilator.log
+			./sim_verilator $sim_args > sim_verilator.log
 		fi
 	fi
 fi
@@ -0,0 +1,278 @@
+#ifndef VERILATOR_TB_BIN_H
+#define VERILATOR_TB_BIN_H
+
+// Word-level variant of verilator_tb.h, see verilator_tb_bin.sh
+//
+// All files are native (little-endian) 32 bit words, starting with an
+// 8 byte magic, the number of patterns and the words per pattern:
+//
+//   VTBPAT1  patterns, bit 0 of word 0 is the LSB of the last input
+//   VTBREF1  reference values, value words then x-mask words per pattern
+//   VTBRES1  results, the words of each output in order per pattern
+//
+// verilator_tb_pack.py converts between these and the text formats.
+
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define VTB_MAGIC_PAT "VTBPAT1\n"
+#define VTB_MAGIC_REF "VTBREF1\n"
+#define VTB_MAGIC_RES "VTBRES1\n"
+#define VTB_FLUSH_WORDS 16384
+
+Vtestbench tb;
+
+struct vtb_file_t {
+	uint32_t count, words;
+	std::vector<uint32_t> data;
+};
+
+vtb_file_t vtb_pat, vtb_ref;
+bool vtb_have_ref, vtb_text;
+FILE *vtb_res_f;
+bool vtb_res_header;
+
+uint32_t vtb_idx, vtb_res_words;
+const uint32_t *vtb_pat_p, *vtb_ref_p;
+int vtb_cursor;
+uint64_t vtb_mismatches;
+
+std::vector<uint32_t> vtb_res_buf;
+std::string vtb_text_buf, vtb_input_text;
+std::vector<std::string> vtb_input_lines;
+
+static inline void vtb_die(const char *msg, const char *arg)
+{
+	fprintf(stderr, "verilator_tb_bin: %s%s\n", msg, arg);
+	exit(2);
+}
+
+static inline void vtb_read(vtb_file_t &f, const char *filename, const char *magic)
+{
+	FILE *fp = fopen(filename, "rb");
+	if (fp == NULL)
+		vtb_die("cannot open ", filename);
+
+	char buffer[8];
+	uint32_t hdr[2];
+	if (fread(buffer, 1, 8, fp) != 8 || memcmp(buffer, magic, 8) || fread(hdr, 4, 2, fp) != 2)
+		vtb_die("bad header in ", filename);
+	f.count = hdr[0];
+	f.words = hdr[1];
+
+	size_t n = size_t(f.count) * f.words;
+	f.data.resize(n);
+	if (fread(f.data.data(), 4, n, fp) != n)
+		vtb_die("short file ", filename);
+	fclose(fp);
+}
+
+static inline void vtb_flush()
+{
+	if (vtb_res_f == NULL)
+		return;
+	if (!vtb_res_header) {
+		uint32_t hdr[2] = { vtb_pat.count, vtb_res_words };
+		fwrite(VTB_MAGIC_RES, 1, 8, vtb_res_f);
+		fwrite(hdr, 4, 2, vtb_res_f);
+		vtb_res_header = true;
+	}
+	fwrite(vtb_res_buf.data(), 4, vtb_res_buf.size(), vtb_res_f);
+	vtb_res_buf.clear();
+}
+
+// Usage: sim_verilator -p patterns.bin [-o results.bin] [-r reference.bin] [-t]
+//
+// Results go to stdout unless -t (text output as verilator_tb.h) is given.
+// Undefined bits are only printed as 'x' with -r, which carries the x-masks;
+// without a reference, -t prints them as the values the model computed.
+static inline void vtb_init(int argc, char **argv)
+{
+	const char *res_file = NULL;
+	bool have_pat = false;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-t")) {
+			vtb_text = true;
+		} else if (i+1 < argc && !strcmp(argv[i], "-p")) {
+			vtb_read(vtb_pat, argv[++i], VTB_MAGIC_PAT);
+			have_pat = true;
+		} else if (i+1 < argc && !strcmp(argv[i], "-r")) {
+			vtb_read(vtb_ref, argv[++i], VTB_MAGIC_REF);
+			vtb_have_ref = true;
+		} else if (i+1 < argc && !strcmp(argv[i], "-o")) {
+			res_file = argv[++i];
+		} else
+			vtb_die("unknown argument ", argv[i]);
+	}
+
+	if (!have_pat)
+		vtb_die("missing -p <patterns>", "");
+	if (vtb_have_ref && vtb_ref.count != vtb_pat.count)
+		vtb_die("reference and pattern counts differ", "");
+
+	if (res_file != NULL) {
+		vtb_res_f = fopen(res_file, "wb");
+		if (vtb_res_f == NULL)
+			vtb_die("cannot create ", res_file);
+	} else if (!vtb_text)
+		vtb_res_f = stdout;
+}
+
+static inline bool vtb_next_pattern()
+{
+	if (vtb_idx >= vtb_pat.count)
+		return false;
+	vtb_pat_p = vtb_pat.data.data() + size_t(vtb_idx) * vtb_pat.words;
+	vtb_ref_p = vtb_have_ref ? vtb_ref.data.data() + size_t(vtb_idx) * vtb_ref.words : NULL;
+	vtb_cursor = 0;
+	vtb_res_words = 0;
+	if (vtb_text) {
+		vtb_input_text.clear();
+		vtb_input_lines.clear();
+	}
+	return true;
+}
+
+// 32 pattern bits starting at bit 'lsb', zero beyond the end of the pattern
+static inline uint32_t vtb_pat_word(int lsb)
+{
+	uint32_t w = lsb >> 5, s = lsb & 31;
+	uint32_t lo = w < vtb_pat.words ? vtb_pat_p[w] : 0;
+	if (s == 0)
+		return lo;
+	uint32_t hi = w+1 < vtb_pat.words ? vtb_pat_p[w+1] : 0;
+	return (lo >> s) | (hi << (32 - s));
+}
+
+static inline uint32_t vtb_top_mask(int bits)
+{
+	return (bits % 32) ? (uint32_t(1) << (bits % 32)) - 1 : ~uint32_t(0);
+}
+
+static inline void vtb_bits_text(std::string &s, const uint32_t *words, const uint32_t *xmask, int bits)
+{
+	for (int i = bits-1; i >= 0; i--) {
+		uint32_t b = uint32_t(1) << (i % 32);
+		s += (xmask && (xmask[i/32] & b)) ? 'x' : (words[i/32] & b) ? '1' : '0';
+	}
+}
+
+static inline void vtb_input_done(const char *name, const uint32_t *words, int bits)
+{
+	vtb_cursor += bits;
+	if (!vtb_text)
+		return;
+	std::string s;
+	vtb_bits_text(s, words, NULL, bits);
+	vtb_input_lines.push_back("++PAT++ " + std::to_string(vtb_idx) + " " + name + " " + s + " #\n");
+	vtb_input_text = s + (vtb_input_text.empty() ? "" : " ") + vtb_input_text;
+}
+
+static inline uint64_t vtb_input64(const char *name, int bits)
+{
+	uint64_t v = vtb_pat_word(vtb_cursor);
+	if (bits > 32)
+		v |= uint64_t(vtb_pat_word(vtb_cursor + 32)) << 32;
+	if (bits < 64)
+		v &= (uint64_t(1) << bits) - 1;
+	uint32_t words[2] = { uint32_t(v), uint32_t(v >> 32) };
+	vtb_input_done(name, words, bits);
+	return v;
+}
+
+// Overloads rather than a template so VlWide ports convert to WData*
+static inline void vtb_input(const char *name, CData &data, int bits) { data = vtb_input64(name, bits); }
+static inline void vtb_input(const char *name, SData &data, int bits) { data = vtb_input64(name, bits); }
+static inline void vtb_input(const char *name, IData &data, int bits) { data = vtb_input64(name, bits); }
+static inline void vtb_input(const char *name, QData &data, int bits) { data = vtb_input64(name, bits); }
+
+static inline void vtb_input(const char *name, WData *data, int bits)
+{
+	int n = (bits + 31) / 32;
+	for (int i = 0; i < n; i++)
+		data[i] = vtb_pat_word(vtb_cursor + 32*i);
+	data[n-1] &= vtb_top_mask(bits);
+	vtb_input_done(name, data, bits);
+}
+
+static inline void vtb_output_words(const char *name, const uint32_t *words, int bits)
+{
+	int n = (bits + 31) / 32;
+	vtb_res_buf.insert(vtb_res_buf.end(), words, words + n);
+	vtb_res_words += n;
+
+	const uint32_t *xmask = NULL;
+	if (vtb_ref_p != NULL) {
+		if (uint32_t(2*n) != vtb_ref.words)
+			vtb_die("reference width differs from output ", name);
+		xmask = vtb_ref_p + n;
+		for (int i = 0; i < n; i++)
+			if ((words[i] ^ vtb_ref_p[i]) & ~xmask[i]) {
+				std::string got, exp;
+				vtb_bits_text(got, words, xmask, bits);
+				vtb_bits_text(exp, vtb_ref_p, xmask, bits);
+				fprintf(stderr, "++DIFF++ %u %s %s %s\n", vtb_idx, name, got.c_str(), exp.c_str());
+				vtb_mismatches++;
+				break;
+			}
+	}
+
+	if (vtb_text) {
+		std::string s;
+		vtb_bits_text(s, words, xmask, bits);
+		vtb_text_buf += "++VAL++ " + std::to_string(vtb_idx) + " " + name + " " + s + " #\n";
+		vtb_text_buf += "++RPT++ " + std::to_string(vtb_idx) + " " + vtb_input_text + " " + s + " " + name + "\n";
+	}
+}
+
+static inline void vtb_output64(const char *name, uint64_t data, int bits)
+{
+	uint32_t words[2] = { uint32_t(data), uint32_t(data >> 32) };
+	vtb_output_words(name, words, bits);
+}
+
+static inline void vtb_output(const char *name, CData data, int bits) { vtb_output64(name, data, bits); }
+static inline void vtb_output(const char *name, SData data, int bits) { vtb_output64(name, data, bits); }
+static inline void vtb_output(const char *name, IData data, int bits) { vtb_output64(name, data, bits); }
+static inline void vtb_output(const char *name, QData data, int bits) { vtb_output64(name, data, bits); }
+
+static inline void vtb_output(const char *name, const WData *data, int bits)
+{
+	vtb_output_words(name, data, bits);
+}
+
+static inline void vtb_end_pattern()
+{
+	if (vtb_text) {
+		std::string pat;
+		for (int i = int(vtb_input_lines.size())-1; i >= 0; i--)
+			pat += vtb_input_lines[i];
+		fputs(pat.c_str(), stdout);
+		fputs(vtb_text_buf.c_str(), stdout);
+		fputs("++RPT++ ----\n", stdout);
+		vtb_text_buf.clear();
+	}
+	if (vtb_res_buf.size() >= VTB_FLUSH_WORDS)
+		vtb_flush();
+	vtb_idx++;
+}
+
+static inline int vtb_finish()
+{
+	vtb_flush();
+	if (vtb_res_f != NULL && vtb_res_f != stdout)
+		fclose(vtb_res_f);
+	if (vtb_have_ref)
+		fprintf(stderr, "++CMP++ %llu mismatches in %u patterns\n",
+				(unsigned long long)vtb_mismatches, vtb_pat.count);
+	if (vtb_text)
+		printf("++OK++\n");
+	return vtb_mismatches ? 1 : 0;
+}
+
+#endif
@@ -0,0 +1,45 @@
+#!/bin/bash
+#
+# Like verilator_tb.sh, but the generated program reads its patterns from a
+# binary file at run time (see verilator_tb_bin.h), so only the ports are
+# given here:
+#
+#   bash verilator_tb_bin.sh <rtl> <syn_list> <inp_list> > sim_verilator.cc
+
+rtl=$1
+syn_list=$( echo $2 | tr , ' ' )
+inp_list=$( echo $3 | tr , ' ' )
+
+cat << EOT
+#include "obj_dir/Vtestbench.h"
+#include "verilated.cpp"
+#include "../../scripts/verilator_tb_bin.h"
+
+// bash $0 $*
+
+// rtl=$rtl
+// syn_list=$syn_list
+// inp_list=$inp_list
+
+int main(int argc, char **argv) {
+	vtb_init(argc, argv);
+	while (vtb_next_pattern()) {
+EOT
+
+for inp in $inp_list; do
+	bits=$( expr $( sed "/input.* $inp;/ !d; s/.*\[//; s/:.*//;" rtl.v ) + 1 )
+	echo "		vtb_input(\"$inp\", tb.$inp, $bits);"
+done | tac
+echo "		tb.eval();"
+bits=$( expr $( sed "/output.* y;/ !d; s/.*\[//; s/:.*//;" rtl.v ) + 1 )
+for syn in $syn_list; do
+	echo "		vtb_output(\"$syn\", tb.${syn}_y, $bits);"
+done
+
+cat << EOT
+		vtb_end_pattern();
+	}
+	tb.final();
+	return vtb_finish();
+}
+EOT
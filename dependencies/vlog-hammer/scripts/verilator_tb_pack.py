@@ -0,0 +1,101 @@
+#!/usr/bin/python3
+#
+# Convert between the text formats used by report.sh and the binary files
+# read and written by verilator_tb_bin.h:
+#
+#   verilator_tb_pack.py patterns <out.bin> <bits> <pattern,...>
+#       pack patterns (as given to verilator_tb.sh) of <bits> input bits
+#
+#   verilator_tb_pack.py reference <out.bin> <sim.log> <name>
+#       pack the ++VAL++ values of output <name>, with 'x' bits masked
+#
+#   verilator_tb_pack.py results <in.bin> <bits> <name,...>
+#       print ++VAL++ lines for results with outputs <name,...> of <bits> bits
+
+import re
+import sys
+import struct
+
+def words_for(bits):
+  return (bits + 31) // 32
+
+def to_words(value, nwords):
+  return [ (value >> (32*i)) & 0xffffffff for i in range(nwords) ]
+
+def write_file(filename, magic, count, nwords, words):
+  f = open(filename, "wb")
+  f.write(magic)
+  f.write(struct.pack("<II", count, nwords))
+  f.write(struct.pack("<%dI" % len(words), *words))
+  f.close()
+
+def read_file(filename, magic):
+  data = open(filename, "rb").read()
+  if data[0:8] != magic:
+    sys.exit("%s: bad header" % filename)
+  count, nwords = struct.unpack("<II", data[8:16])
+  words = struct.unpack("<%dI" % (count*nwords), data[16:16+4*count*nwords])
+  return count, nwords, words
+
+def parse_pattern(pattern, bits):
+  # same syntax as set_pattern() in verilator_tb.h
+  m = re.match("^(~?)[0-9]*'?([bh])([0-9a-fA-F]+)$", pattern)
+  if not m:
+    sys.exit("bad pattern: %s" % pattern)
+  value = int(m.group(3), 2 if m.group(2) == 'b' else 16)
+  if m.group(1):
+    value = ~value
+  return value & ((1 << bits) - 1)
+
+def parse_bits(text):
+  value = int(re.sub("[xXzZ]", "0", text), 2)
+  mask = int(re.sub("[01]", "0", re.sub("[xXzZ]", "1", text)), 2)
+  return value, mask
+
+mode = sys.argv[1] if len(sys.argv) == 5 else ""
+
+if mode == "patterns":
+  bits = int(sys.argv[3])
+  nwords = words_for(bits)
+  patterns = [ p for p in sys.argv[4].split(",") if p ]
+  words = [ ]
+  for p in patterns:
+    words += to_words(parse_pattern(p, bits), nwords)
+  write_file(sys.argv[2], b"VTBPAT1\n", len(patterns), nwords, words)
+
+elif mode == "reference":
+  re_parse_val = re.compile(r'\+\+VAL\+\+ +(\S+) +(\S+) +(\S+)')
+  values = { }
+  bits = 0
+  for line in open(sys.argv[3], "r"):
+    m = re_parse_val.search(line)
+    if m and m.group(2) == sys.argv[4]:
+      values[int(m.group(1))] = parse_bits(m.group(3))
+      bits = len(m.group(3))
+  if not values:
+    sys.exit("%s: no values of %s" % (sys.argv[3], sys.argv[4]))
+  if sorted(values.keys()) != list(range(len(values))):
+    sys.exit("%s: patterns of %s are not numbered 0..N-1" % (sys.argv[3], sys.argv[4]))
+  nwords = words_for(bits)
+  words = [ ]
+  for idx in range(len(values)):
+    words += to_words(values[idx][0], nwords) + to_words(values[idx][1], nwords)
+  write_file(sys.argv[2], b"VTBREF1\n", len(values), 2*nwords, words)
+
+elif mode == "results":
+  bits = int(sys.argv[3])
+  nwords = words_for(bits)
+  names = sys.argv[4].split(",")
+  count, pwords, words = read_file(sys.argv[2], b"VTBRES1\n")
+  if pwords != nwords * len(names):
+    sys.exit("%s: %d words per pattern, expected %d" % (sys.argv[2], pwords, nwords * len(names)))
+  for idx in range(count):
+    for i, name in enumerate(names):
+      base = idx*pwords + i*nwords
+      value = 0
+      for j in range(nwords):
+        value |= words[base + j] << (32*j)
+      print("++VAL++ %d %s %s #" % (idx, name, format(value, "0%db" % bits)))
+
+else:
+  sys.exit("usage: %s patterns|reference|results <file> <arg> <arg>" % sys.argv[0])